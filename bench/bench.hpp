@@ -0,0 +1,34 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+//minimal timing helpers for the programs in this directory, see run.sh
+namespace bench {
+	///keeps value alive, so the optimizer cannot drop the work that produced it
+	template<class T>
+	inline void keep(const T & value) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const volatile void * sink;
+		sink = &value;
+#else
+		asm volatile("" : : "g"(&value) : "memory");
+#endif
+	}
+	///best wall time of reps runs of f, in seconds
+	template<class F>
+	double best_of(unsigned reps, F && f) {
+		double best = 1e30;
+		for (unsigned i = 0; i < reps; ++i) {
+			const auto start = std::chrono::steady_clock::now();
+			f();
+			const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			if (t < best)
+				best = t;
+		}
+		return best;
+	}
+	///prints "name: ns per op"
+	inline void report(const char * name, double seconds, double ops) {
+		std::printf("%-44s %10.2f ns/op\n", name, seconds * 1e9 / ops);
+	}
+}
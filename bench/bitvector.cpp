@@ -0,0 +1,87 @@
+//BitVector against Vector<char> and std::vector<bool>: memory, count, AND, set-bit iteration
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "BitVector.hpp"
+#include "Vector.hpp"
+
+using namespace gc::container;
+
+constexpr unsigned length = 1u << 24;
+
+void report(const char * name, double seconds) {
+	std::printf("%-44s %10.1f us per %u flags\n", name, seconds * 1e6, length);
+}
+
+int main() {
+	std::mt19937 rng(3);
+	auto bits_a = BitVector<>::make(length).unwrap_value();
+	auto bits_b = BitVector<>::make(length).unwrap_value();
+	auto chars_a = Vector<char>::make(length, char(0)).unwrap_value();
+	auto chars_b = Vector<char>::make(length, char(0)).unwrap_value();
+	std::vector<bool> bools_a(length), bools_b(length);
+	//about 1 bit in 8 is set
+	for (unsigned i = 0; i < length; ++i) {
+		const bool a = rng() % 8 == 0, b = rng() % 8 == 0;
+		bits_a.set(i, a);
+		bits_b.set(i, b);
+		chars_a.begin()[i] = a;
+		chars_b.begin()[i] = b;
+		bools_a[i] = a;
+		bools_b[i] = b;
+	}
+	std::printf("memory for %u flags: BitVector %u KB, Vector<char> %u KB\n\n", length, length / 8 / 1024, length / 1024);
+
+	report("count: BitVector", bench::best_of(10, [&] { bench::keep(bits_a.count()); }));
+	report("count: Vector<char>", bench::best_of(10, [&] {
+		unsigned n = 0;
+		for (char c : chars_a)
+			n += c;
+		bench::keep(n);
+	}));
+	report("count: std::vector<bool>", bench::best_of(10, [&] {
+		unsigned n = 0;
+		for (bool b : bools_a)
+			n += b;
+		bench::keep(n);
+	}));
+
+	report("and: BitVector::and_with", bench::best_of(10, [&] {
+		bits_a.and_with(bits_b);
+		bench::keep(bits_a);
+	}));
+	report("and: Vector<char>", bench::best_of(10, [&] {
+		char * a = chars_a.begin();
+		const char * b = chars_b.begin();
+		for (unsigned i = 0; i < length; ++i)
+			a[i] &= b[i];
+		bench::keep(a);
+	}));
+	report("and: std::vector<bool>", bench::best_of(10, [&] {
+		for (unsigned i = 0; i < length; ++i)
+			bools_a[i] = bools_a[i] && bools_b[i];
+		bench::keep(bools_a);
+	}));
+
+	report("iterate set bits: BitVector::ones", bench::best_of(10, [&] {
+		unsigned long long sum = 0;
+		bits_b.ones().foreach([&](unsigned i) { sum += i; });
+		bench::keep(sum);
+	}));
+	report("iterate set bits: Vector<char>", bench::best_of(10, [&] {
+		unsigned long long sum = 0;
+		const char * b = chars_b.begin();
+		for (unsigned i = 0; i < length; ++i)
+			if (b[i])
+				sum += i;
+		bench::keep(sum);
+	}));
+	report("iterate set bits: std::vector<bool>", bench::best_of(10, [&] {
+		unsigned long long sum = 0;
+		for (unsigned i = 0; i < length; ++i)
+			if (bools_b[i])
+				sum += i;
+		bench::keep(sum);
+	}));
+}
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+# compile time of long on_success/map_result_type chains: ./compile_time.py [include_dir ...]
+# generates one translation unit with thousands of chained calls, each with its own lambda, so every call
+# instantiates the member template and its trait checks anew, then for every include directory prints:
+# best wall time of g++ -fsyntax-only, template instantiation time from -ftime-report
+# and the number of class template instantiations from -fdump-lang-class (g++ has no direct counter)
+import argparse
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+here = os.path.dirname(os.path.abspath(__file__))
+
+
+def generate(calls, chain_length):
+	lines = ['#include "Result.hpp"', '']
+	for c in range(calls // chain_length):
+		lines.append('gc::Result<long long, gc::Error> chain_%d(int seed) noexcept {' % c)
+		lines.append('\tgc::Result<int, gc::Error> r = gc::Ok(static_cast<int>(seed));')
+		lines.append('\treturn r')
+		value = 'int'
+		for i in range(chain_length):
+			k = c * chain_length + i
+			if i % 2 == 0:
+				lines.append('\t\t.on_success([](%s && v) noexcept { return gc::Ok(static_cast<%s>(v + %d)); })' % (value, value, k))
+			else:
+				other = 'long long' if value == 'int' else 'int'
+				lines.append('\t\t.map_result_type<%s>([](%s && v) noexcept { return gc::Ok(static_cast<%s>(v ^ %d)); })'
+					% (other, value, other, k))
+				value = other
+		if value != 'long long':
+			lines.append('\t\t.map_result_type<long long>([](int && v) noexcept { return gc::Ok(static_cast<long long>(v)); })')
+		lines.append('\t\t.move();')
+		lines.append('}')
+	lines.append('')
+	return '\n'.join(lines)
+
+
+def compile(cxx, include, source, extra):
+	res = subprocess.run([cxx, '-std=c++20', '-fsyntax-only', '-I', include, source] + extra,
+		capture_output=True, text=True, cwd=os.path.dirname(source))
+	if res.returncode != 0:
+		sys.exit(res.stderr)
+	return res
+
+
+def main():
+	parser = argparse.ArgumentParser()
+	parser.add_argument('include', nargs='*', default=[os.path.join(here, '..', 'Проект1', 'Проект1')])
+	parser.add_argument('--calls', type=int, default=4000)
+	parser.add_argument('--chain', type=int, default=50, help='calls per chain')
+	parser.add_argument('--reps', type=int, default=3)
+	args = parser.parse_args()
+	cxx = os.environ.get('CXX', 'g++')
+
+	with tempfile.TemporaryDirectory() as tmp:
+		source = os.path.join(tmp, 'chains.cpp')
+		with open(source, 'w') as f:
+			f.write(generate(args.calls, args.chain))
+		print('%d chained calls in chains of %d, %s' % (args.calls - args.calls % args.chain, args.chain, cxx))
+		for include in args.include:
+			include = os.path.abspath(include)
+			best = 1e30
+			for _ in range(args.reps):
+				start = time.perf_counter()
+				compile(cxx, include, source, [])
+				best = min(best, time.perf_counter() - start)
+
+			report = compile(cxx, include, source, ['-ftime-report']).stderr
+			match = re.search(r'template instantiation\s*:\s*([\d.]+)\s*\(\s*(\d+)%\)', report)
+			instantiation = '%ss (%s%%)' % match.groups() if match else 'n/a'
+
+			for name in os.listdir(tmp):
+				if name.endswith('.class'):
+					os.remove(os.path.join(tmp, name))
+			compile(cxx, include, source, ['-fdump-lang-class'])
+			classes = gc_classes = 0
+			for name in os.listdir(tmp):
+				if name.endswith('.class'):
+					with open(os.path.join(tmp, name)) as dump:
+						for line in dump:
+							if line.startswith('Class ') and '<' in line:
+								classes += 1
+								gc_classes += line.startswith('Class gc::')
+			print('%s\n  wall %.2fs, template instantiation %s, class template instantiations %d (gc:: %d)'
+				% (include, best, instantiation, classes, gc_classes))
+
+
+if __name__ == '__main__':
+	sys.exit(main())
@@ -0,0 +1,116 @@
+//ObjectPool against a preallocated Vector with free-index list and generations: churn and iteration
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "ObjectPool.hpp"
+#include "Vector.hpp"
+
+using namespace gc::container;
+
+struct Particle {
+	float x, y, vx, vy;
+};
+
+constexpr unsigned live = 1u << 16;
+constexpr unsigned slots = live * 2;//Vector keeps this many slots, half of them are free after the fill
+constexpr unsigned churn = 1u << 20;
+
+///what a caller writes by hand on top of Vector: slot index plus generation, free slots on a stack
+struct IndexedVector {
+	struct Handle {
+		unsigned index, generation;
+	};
+	Vector<Particle> items;
+	std::vector<unsigned> generation;//odd while the slot is live
+	std::vector<unsigned> free;
+
+	IndexedVector() :
+		items(Vector<Particle>::make(slots, Particle{}).unwrap_value()), generation(slots, 0)
+	{
+		for (unsigned i = slots; i-- > 0;)
+			free.push_back(i);
+	}
+	Handle acquire(const Particle & p) {
+		const unsigned i = free.back();
+		free.pop_back();
+		items.begin()[i] = p;
+		return { i, ++generation[i] };
+	}
+	bool release(const Handle & h) {
+		if (generation[h.index] != h.generation)
+			return false;
+		++generation[h.index];
+		free.push_back(h.index);
+		return true;
+	}
+	template<class F>
+	void foreach(F && f) {
+		for (unsigned i = 0; i < slots; ++i)
+			if (generation[i] & 1)
+				f(items.begin()[i]);
+	}
+};
+
+int main() {
+	std::mt19937 rng(5);
+	std::vector<unsigned> picks(churn);
+	for (unsigned & p : picks)
+		p = rng() % live;
+
+	auto pool = ObjectPool<Particle>::make_with_capacity(live).unwrap_value();
+	std::vector<ObjectPool<Particle>::Handle> pool_handles;
+	IndexedVector vec;
+	std::vector<IndexedVector::Handle> vec_handles;
+	//fill every other slot, so the Vector has holes as after a while of churn
+	for (unsigned i = 0; i < slots; ++i) {
+		const Particle p{ float(i), 0, 1, 1 };
+		auto h = vec.acquire(p);
+		if (i % 2 == 0) {
+			vec_handles.push_back(h);
+			pool_handles.push_back(pool.acquire(p).unwrap_value());
+		}
+		else
+			vec.release(h);
+	}
+
+	bench::report("churn: ObjectPool release + acquire", bench::best_of(5, [&] {
+		for (unsigned p : picks) {
+			pool.release(pool_handles[p]);
+			pool_handles[p] = pool.acquire(Particle{ float(p), 0, 1, 1 }).unwrap_value();
+		}
+		bench::keep(pool_handles);
+	}), churn);
+	bench::report("churn: Vector + free-index list", bench::best_of(5, [&] {
+		for (unsigned p : picks) {
+			vec.release(vec_handles[p]);
+			vec_handles[p] = vec.acquire(Particle{ float(p), 0, 1, 1 });
+		}
+		bench::keep(vec_handles);
+	}), churn);
+
+	bench::report("update live: ObjectPool::whole", bench::best_of(20, [&] {
+		pool.whole().foreach([](Particle & p) { p.x += p.vx; p.y += p.vy; });
+		bench::keep(pool);
+	}), live);
+	bench::report("update live: Vector, skip free slots", bench::best_of(20, [&] {
+		vec.foreach([](Particle & p) { p.x += p.vx; p.y += p.vy; });
+		bench::keep(vec);
+	}), live);
+
+	bench::report("lookup: ObjectPool::Handle::get", bench::best_of(5, [&] {
+		float sum = 0;
+		for (unsigned p : picks)
+			sum += pool_handles[p].get().unwrap_value().x;
+		bench::keep(sum);
+	}), churn);
+	bench::report("lookup: Vector index + generation check", bench::best_of(5, [&] {
+		float sum = 0;
+		for (unsigned p : picks) {
+			const auto & h = vec_handles[p];
+			if (vec.generation[h.index] == h.generation)
+				sum += vec.items.begin()[h.index].x;
+		}
+		bench::keep(sum);
+	}), churn);
+}
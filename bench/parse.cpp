@@ -0,0 +1,72 @@
+//gc::parse<T> on a CSV-style buffer against std::stoi/std::strtol and std::strtod
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "bench.hpp"
+#include "String.hpp"
+
+using gc::container::StringView;
+
+constexpr unsigned fields = 1u << 20;
+
+//comma separated fields, whole buffer is one std::string, so every parser reads the same memory
+template<class F>
+std::string make_csv(F && field) {
+	std::string csv;
+	for (unsigned i = 0; i < fields; ++i) {
+		csv += field(i);
+		csv += ',';
+	}
+	return csv;
+}
+//calls f(first, length) for every field
+template<class F>
+void split(const std::string & csv, F && f) {
+	const char * p = csv.data();
+	const char * end = p + csv.size();
+	while (p < end) {
+		const char * comma = static_cast<const char *>(std::memchr(p, ',', end - p));
+		f(p, unsigned(comma - p));
+		p = comma + 1;
+	}
+}
+
+int main() {
+	std::mt19937 rng(42);
+	const std::string ints = make_csv([&](unsigned) { return std::to_string(int(rng())); });
+	const std::string doubles = make_csv([&](unsigned) { return std::to_string(double(rng()) / 1000.0); });
+	const double int_mb = ints.size() / 1e6;
+	const double double_mb = doubles.size() / 1e6;
+
+	auto report = [](const char * name, double seconds, double mb) {
+		std::printf("%-44s %10.2f ns/field %8.1f MB/s\n", name, seconds * 1e9 / fields, mb / seconds);
+	};
+
+	report("gc::parse<int>", bench::best_of(5, [&] {
+		long long sum = 0;
+		split(ints, [&](const char * p, unsigned n) { sum += gc::parse<int>(StringView{ p, n }).unwrap_value(); });
+		bench::keep(sum);
+	}), int_mb);
+	report("std::stoi(std::string)", bench::best_of(5, [&] {
+		long long sum = 0;
+		split(ints, [&](const char * p, unsigned n) { sum += std::stoi(std::string(p, n)); });
+		bench::keep(sum);
+	}), int_mb);
+	report("std::strtol", bench::best_of(5, [&] {
+		long long sum = 0;
+		split(ints, [&](const char * p, unsigned) { sum += std::strtol(p, nullptr, 10); });
+		bench::keep(sum);
+	}), int_mb);
+
+	report("gc::parse<double>", bench::best_of(5, [&] {
+		double sum = 0;
+		split(doubles, [&](const char * p, unsigned n) { sum += gc::parse<double>(StringView{ p, n }).unwrap_value(); });
+		bench::keep(sum);
+	}), double_mb);
+	report("std::strtod", bench::best_of(5, [&] {
+		double sum = 0;
+		split(doubles, [&](const char * p, unsigned) { sum += std::strtod(p, nullptr); });
+		bench::keep(sum);
+	}), double_mb);
+}
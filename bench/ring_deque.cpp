@@ -0,0 +1,113 @@
+//push/pop at both ends and windowed iteration of RingBuffer and Deque against std::deque
+#include <deque>
+
+#include "bench.hpp"
+#include "RingBuffer.hpp"
+#include "Deque.hpp"
+
+using namespace gc::container;
+
+constexpr unsigned n = 1u << 20;
+constexpr unsigned window = 64;
+
+int main() {
+	//fifo: fill to n, then n times push at one end and pop at the other
+	bench::report("RingBuffer push_back/pop_front", bench::best_of(5, [] {
+		auto r = RingBuffer<int>::make_with_capacity(n).unwrap_value();
+		for (unsigned i = 0; i < n; ++i)
+			r.push_back(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += r.pop_front().unwrap_value();
+			r.push_back(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+	bench::report("Deque push_back/pop_front", bench::best_of(5, [] {
+		auto d = Deque<int>::make();
+		for (unsigned i = 0; i < n; ++i)
+			d.push_back(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += d.pop_front().unwrap_value();
+			d.push_back(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+	bench::report("std::deque push_back/pop_front", bench::best_of(5, [] {
+		std::deque<int> d;
+		for (unsigned i = 0; i < n; ++i)
+			d.push_back(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += d.front();
+			d.pop_front();
+			d.push_back(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+
+	bench::report("RingBuffer push_front/pop_back", bench::best_of(5, [] {
+		auto r = RingBuffer<int>::make_with_capacity(n).unwrap_value();
+		for (unsigned i = 0; i < n; ++i)
+			r.push_front(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += r.pop_back().unwrap_value();
+			r.push_front(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+	bench::report("Deque push_front/pop_back", bench::best_of(5, [] {
+		auto d = Deque<int>::make();
+		for (unsigned i = 0; i < n; ++i)
+			d.push_front(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += d.pop_back().unwrap_value();
+			d.push_front(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+	bench::report("std::deque push_front/pop_back", bench::best_of(5, [] {
+		std::deque<int> d;
+		for (unsigned i = 0; i < n; ++i)
+			d.push_front(int(i));
+		long long sum = 0;
+		for (unsigned i = 0; i < n; ++i) {
+			sum += d.back();
+			d.pop_back();
+			d.push_front(int(i));
+		}
+		bench::keep(sum);
+	}), 3.0 * n);
+
+	//sliding window: sum of every window of 64 elements
+	auto r = RingBuffer<int>::make_with_capacity(n).unwrap_value();
+	auto d = Deque<int>::make();
+	std::deque<int> sd;
+	for (unsigned i = 0; i < n; ++i) {
+		r.push_back(int(i));
+		d.push_back(int(i));
+		sd.push_back(int(i));
+	}
+	bench::report("RingBuffer window(64) sum", bench::best_of(5, [&] {
+		long long sum = 0;
+		for (unsigned i = 0; i + window <= n; i += 16)
+			r.window(i, window).unwrap_value().foreach([&](int v) { sum += v; });
+		bench::keep(sum);
+	}), double(n / 16) * window);
+	bench::report("Deque window(64) sum", bench::best_of(5, [&] {
+		long long sum = 0;
+		for (unsigned i = 0; i + window <= n; i += 16)
+			d.window(i, window).unwrap_value().foreach([&](int v) { sum += v; });
+		bench::keep(sum);
+	}), double(n / 16) * window);
+	bench::report("std::deque window(64) sum", bench::best_of(5, [&] {
+		long long sum = 0;
+		for (unsigned i = 0; i + window <= n; i += 16)
+			for (auto j = sd.begin() + i, e = j + window; j != e; ++j)
+				sum += *j;
+		bench::keep(sum);
+	}), double(n / 16) * window);
+}
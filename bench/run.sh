@@ -0,0 +1,9 @@
+#!/bin/sh
+# builds and runs one benchmark: ./run.sh ring_deque
+# CXX and CXXFLAGS can be overridden, headers are taken from the project directory
+set -e
+cd "$(dirname "$0")"
+name="$1"
+shift
+${CXX:-g++} -std=c++20 -O2 -march=native -DNDEBUG ${CXXFLAGS} -I"../Проект1/Проект1" "$name.cpp" -o "$name.out" -pthread "$@"
+"./$name.out"
@@ -0,0 +1,65 @@
+//serialize/deserialize/view throughput of a trivially copyable Vector and of nested Vectors, in GB/s
+#include <cstring>
+
+#include "bench.hpp"
+#include "Serialization.hpp"
+
+using namespace gc::container;
+namespace ser = gc::serialization;
+using Alloc = gc::memory::Allocator;
+
+constexpr unsigned flat_length = 16u << 20;//64MB of int
+constexpr unsigned rows = 1u << 16;
+constexpr unsigned row_length = 256;//64MB of int in 65536 rows
+
+void report(const char * name, double seconds, double bytes) {
+	std::printf("%-44s %10.2f GB/s\n", name, bytes / seconds / 1e9);
+}
+
+int main() {
+	auto flat = Vector<int>::make_with_init(flat_length, [](int * p) noexcept {
+		for (unsigned i = 0; i < flat_length; ++i)
+			new(p + i) int(i);
+	}).unwrap_value();
+	const double flat_bytes = double(sizeof(int)) * flat_length;
+
+	report("serialize Vector<int>", bench::best_of(5, [&] {
+		auto buffer = ser::serialize(flat).unwrap_value();
+		bench::keep(buffer);
+		Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+	}), flat_bytes);
+	auto buffer = ser::serialize(flat).unwrap_value();
+	report("deserialize Vector<int>", bench::best_of(5, [&] {
+		auto v = ser::deserialize<int>(buffer).unwrap_value();
+		bench::keep(v);
+	}), flat_bytes);
+	report("view<int> + sum", bench::best_of(5, [&] {
+		long long sum = 0;
+		ser::view<int>(buffer).unwrap_value().foreach([&](const int & i) { sum += i; });
+		bench::keep(sum);
+	}), flat_bytes);
+	report("memcpy (reference)", bench::best_of(5, [&] {
+		auto copy = Alloc::allocate(unsigned(flat_bytes), alignof(int)).unwrap_value();
+		std::memcpy(copy.begin_as<void>(), flat.begin(), std::size_t(flat_bytes));
+		bench::keep(copy);
+		Alloc::deallocate(copy.move(), alignof(int));
+	}), flat_bytes);
+	Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+
+	auto nested = Vector<Vector<int>>::make_with_capacity(rows).unwrap_value();
+	for (unsigned i = 0; i < rows; ++i)
+		nested.push(Vector<int>::make(row_length, int(i)).unwrap_value());
+	const double nested_bytes = double(sizeof(int)) * rows * row_length;
+
+	report("serialize Vector<Vector<int>> (256 per row)", bench::best_of(5, [&] {
+		auto buffer = ser::serialize(nested).unwrap_value();
+		bench::keep(buffer);
+		Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+	}), nested_bytes);
+	buffer = ser::serialize(nested).unwrap_value();
+	report("deserialize Vector<Vector<int>>", bench::best_of(5, [&] {
+		auto v = ser::deserialize<Vector<int>>(buffer).unwrap_value();
+		bench::keep(v);
+	}), nested_bytes);
+	Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+}
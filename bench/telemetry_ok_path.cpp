@@ -0,0 +1,41 @@
+//cost of GC_ERROR_TELEMETRY on a Result-returning hot loop, build it with and without the macro: ./telemetry_ok_path.sh
+#include <vector>
+
+#include "bench.hpp"
+#include "Result.hpp"
+#ifdef GC_ERROR_TELEMETRY
+	#include "Telemetry.hpp"
+#endif
+
+constexpr unsigned n = 1u << 22;
+
+//out of line, so the error branch is compiled the same way as in a library function
+[[gnu::noinline]] gc::Result<int, gc::Error> checked_div(int a, int b) noexcept {
+	if (b == 0)
+		return gc::Err(gc::Error::DomainError);
+	return gc::Ok(a / b);
+}
+
+long long run(const std::vector<int> & divisors) {
+	long long sum = 0;
+	for (unsigned i = 0; i < n; ++i) {
+		auto res = checked_div(int(i), divisors[i]);
+		sum += res.is_ok() ? res.unwrap_value() : -1;
+	}
+	return sum;
+}
+
+int main() {
+#ifdef GC_ERROR_TELEMETRY
+	std::printf("GC_ERROR_TELEMETRY on\n");
+#else
+	std::printf("GC_ERROR_TELEMETRY off\n");
+#endif
+	std::vector<int> ok(n, 3);
+	std::vector<int> rare(n, 3);
+	for (unsigned i = 0; i < n; i += 1024)
+		rare[i] = 0;
+
+	bench::report("ok path only", bench::best_of(9, [&] { bench::keep(run(ok)); }), n);
+	bench::report("one error per 1024 calls", bench::best_of(9, [&] { bench::keep(run(rare)); }), n);
+}
@@ -0,0 +1,12 @@
+#!/bin/sh
+# runs telemetry_ok_path with and without GC_ERROR_TELEMETRY and prints the size of checked_div in both builds,
+# blocks the compiler moved out to checked_div [clone .cold] are counted separately
+set -e
+cd "$(dirname "$0")"
+for flags in "" "-DGC_ERROR_TELEMETRY"; do
+	CXXFLAGS="$flags" ./run.sh telemetry_ok_path
+	objdump -d -C --no-show-raw-insn telemetry_ok_path.out \
+		| awk '/<checked_div\(int, int\)>:/ { on = 1; next } /<checked_div\(int, int\) \[clone .cold\]>:/ { cold = 1; next }
+			/^$/ { on = cold = 0 } on && !/nop/ { n++ } cold && !/nop/ { c++ }
+			END { printf "checked_div: %d instructions, %d in .cold\n\n", n, c }'
+done
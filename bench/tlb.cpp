@@ -0,0 +1,47 @@
+//TLB-miss bound random access: pointer chase through a 256MB buffer from Allocator and from HugePageAllocator
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <random>
+#include <utility>
+
+#include "bench.hpp"
+#include "Allocator.hpp"
+#include "HugePageAllocator.hpp"
+
+using namespace gc::memory;
+
+constexpr unsigned length = 1u << 25;//2^25 * 8 bytes = 256MB
+constexpr unsigned steps = 1u << 22;
+
+template<class Alloc>
+void run(const char * name, unsigned alignment) {
+	auto sl = Alloc::allocate(length * sizeof(std::uint64_t), alignment).unwrap_value();
+	std::uint64_t * next = sl.template begin_as<std::uint64_t>();
+	//single cycle through every element (Sattolo), so each load depends on the previous one
+	for (unsigned i = 0; i < length; ++i)
+		next[i] = i;
+	std::mt19937_64 rng(7);
+	for (unsigned i = length - 1; i > 0; --i)
+		std::swap(next[i], next[rng() % i]);
+#ifdef __linux__
+	//how much of the process is backed by transparent huge pages right now
+	std::ifstream smaps("/proc/self/smaps_rollup");
+	for (std::string line; std::getline(smaps, line);)
+		if (line.rfind("AnonHugePages:", 0) == 0)
+			std::printf("%s\n", line.c_str());
+#endif
+	bench::report(name, bench::best_of(5, [&] {
+		std::uint64_t cur = 0;
+		for (unsigned i = 0; i < steps; ++i)
+			cur = next[cur];
+		bench::keep(cur);
+	}), steps);
+	Alloc::deallocate(sl.move(), alignment);
+}
+
+int main() {
+	run<Allocator>("Allocator random pointer chase", alignof(std::uint64_t));
+	run<AlignedAllocator<cache_line_alignment>>("AlignedAllocator<64> random pointer chase", alignof(std::uint64_t));
+	run<HugePageAllocator>("HugePageAllocator random pointer chase", alignof(std::uint64_t));
+}
@@ -1,19 +1,57 @@
 #pragma once
+#include <new>
+
 #include "Result.hpp"
 #include "Memory.hpp"
 
 namespace gc {
 	namespace memory {
+		///alignment which plain operator new already guarantees
+		constexpr unsigned default_alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+		constexpr unsigned cache_line_alignment = 64;
+		///widest SIMD register (AVX)
+		constexpr unsigned simd_alignment = 32;
+
+		constexpr bool is_valid_alignment(unsigned alignment) noexcept {
+			return alignment != 0 && (alignment & (alignment - 1)) == 0;
+		}
+
 		class Allocator {
 		public:
-			static gc::Result<Slice, gc::Error> allocate(unsigned int size) noexcept {
-				auto res = new(std::nothrow) char[size];
+			static gc::Result<Slice, gc::Error> allocate(unsigned int size, unsigned int alignment) noexcept {
+				if (!is_valid_alignment(alignment))
+					return gc::Err(gc::Error::InvalidArgument);
+				void * res = alignment <= default_alignment
+					? ::operator new(size, std::nothrow)
+					: ::operator new(size, std::align_val_t(alignment), std::nothrow);
 				if (!res)
 					return gc::Err(gc::Error::BadAlloc);
 				return gc::Ok(Slice::make(res, size));
 			}
-			static void deallocate(Slice && slice) noexcept {
-				delete(std::nothrow, slice.begin_as<char>());
+			static void deallocate(Slice && slice, unsigned int alignment) noexcept {
+				if (alignment <= default_alignment)
+					::operator delete(slice.begin_as<void>());
+				else
+					::operator delete(slice.begin_as<void>(), std::align_val_t(alignment));
+			}
+		};
+
+		///raises alignment of every request to at least Alignment, e.g. cache_line_alignment or simd_alignment
+		template<unsigned Alignment, class Alloc = Allocator>
+		class AlignedAllocator {
+			static_assert(is_valid_alignment(Alignment),
+				"gc::memory::AlignedAllocator<Alignment> Alignment must be power of two");
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"second template argument do not match gc_allocator trait");
+			static constexpr unsigned _max(unsigned alignment) noexcept {
+				return alignment > Alignment ? alignment : Alignment;
+			}
+		public:
+			static gc::Result<Slice, gc::Error> allocate(unsigned int size, unsigned int alignment) noexcept {
+				return Alloc::allocate(size, _max(alignment));
+			}
+			static void deallocate(Slice && slice, unsigned int alignment) noexcept {
+				Alloc::deallocate(std::move(slice), _max(alignment));
 			}
 		};
 	}
@@ -0,0 +1,376 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
+#if defined(__AVX2__)
+	#include <immintrin.h>
+#endif
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+
+namespace gc {
+	namespace container {
+		namespace detail {
+			//MSVC __popcnt/__popcnt64 emit POPCNT unconditionally, the CPU must support it (x86 since 2008)
+			inline unsigned _popcount(std::uint64_t w) noexcept {
+#if defined(_MSC_VER) && defined(_M_IX86)
+				return __popcnt(unsigned(w)) + __popcnt(unsigned(w >> 32));
+#elif defined(_MSC_VER)
+				return unsigned(__popcnt64(w));
+#else
+				return unsigned(__builtin_popcountll(w));
+#endif
+			}
+			///index of the lowest set bit, w must not be 0
+			inline unsigned _lowest_bit(std::uint64_t w) noexcept {
+#if defined(_MSC_VER) && defined(_M_IX86)
+				//no 64-bit scan on x86, scan the low half and fall back to the high one
+				unsigned long index;
+				if (_BitScanForward(&index, static_cast<unsigned long>(w)))
+					return unsigned(index);
+				_BitScanForward(&index, static_cast<unsigned long>(w >> 32));
+				return unsigned(index) + 32;
+#elif defined(_MSC_VER)
+				unsigned long index;
+				_BitScanForward64(&index, w);
+				return unsigned(index);
+#else
+				return unsigned(__builtin_ctzll(w));
+#endif
+			}
+			//word-parallel operations for BitVector bulk operations, __m256i overloads take 4 words at once
+			struct _And {
+				static std::uint64_t apply(std::uint64_t x, std::uint64_t y) noexcept { return x & y; }
+#if defined(__AVX2__)
+				static __m256i apply(__m256i x, __m256i y) noexcept { return _mm256_and_si256(x, y); }
+#endif
+			};
+			struct _Or {
+				static std::uint64_t apply(std::uint64_t x, std::uint64_t y) noexcept { return x | y; }
+#if defined(__AVX2__)
+				static __m256i apply(__m256i x, __m256i y) noexcept { return _mm256_or_si256(x, y); }
+#endif
+			};
+			struct _Xor {
+				static std::uint64_t apply(std::uint64_t x, std::uint64_t y) noexcept { return x ^ y; }
+#if defined(__AVX2__)
+				static __m256i apply(__m256i x, __m256i y) noexcept { return _mm256_xor_si256(x, y); }
+#endif
+			};
+			struct _AndNot {
+				static std::uint64_t apply(std::uint64_t x, std::uint64_t y) noexcept { return x & ~y; }
+#if defined(__AVX2__)
+				static __m256i apply(__m256i x, __m256i y) noexcept { return _mm256_andnot_si256(y, x); }
+#endif
+			};
+		}
+
+		///bits packed into 64-bit words, 8 times smaller than Vector<bool>
+		template<class Alloc = gc::memory::Allocator>
+		class BitVector : INonCopyable {
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"template argument do not match gc_allocator trait");
+		public:
+			using word = std::uint64_t;
+			static constexpr unsigned word_bits = 64;
+			///longest supported bit vector, word count of a longer one does not fit into unsigned arithmetic
+			static constexpr unsigned max_length = unsigned(-1) - (word_bits - 1);
+
+			///walks over indices of set bits
+			class iterator {
+				const word * _words;
+				unsigned _length;
+				unsigned _index;
+			public:
+				iterator(const word * words, unsigned length, unsigned index) noexcept :
+					_words(words), _length(length), _index(index)
+				{}
+				unsigned operator * () const noexcept { return _index; }
+				iterator & operator ++ () noexcept {
+					_index = BitVector::_find(_words, _length, _index + 1);
+					return *this;
+				}
+				bool operator < (const iterator & rhs) const noexcept { return _index < rhs._index; }
+				bool operator == (const iterator & rhs) const noexcept { return _index == rhs._index; }
+				bool operator != (const iterator & rhs) const noexcept { return _index != rhs._index; }
+			};
+			//container
+			using range = Range<iterator>;
+
+			BitVector(BitVector && b) noexcept;
+			~BitVector() noexcept;
+
+			///number of bits
+			unsigned 	length() const noexcept;
+			///number of set bits
+			unsigned 	count() const noexcept;
+			bool 		empty() const noexcept;
+			BitVector & fill(bool value) noexcept;
+			bool 		operator == (const BitVector & rhs) const noexcept;
+			bool 		operator != (const BitVector & rhs) const noexcept;
+
+			Result<bool, Error> 		at(unsigned index) const noexcept;
+			Result<BitVector &, Error> 	set(unsigned index, bool value = true) noexcept;
+			///OutOfRange if no bit is set
+			Result<unsigned, Error> 	find_first() const noexcept;
+			///first set bit after index, OutOfRange if there is none
+			Result<unsigned, Error> 	find_next(unsigned index) const noexcept;
+
+			///bulk operations, SizeError if lengths differ
+			Result<BitVector &, Error> 	and_with(const BitVector & rhs) noexcept;
+			Result<BitVector &, Error> 	or_with(const BitVector & rhs) noexcept;
+			Result<BitVector &, Error> 	xor_with(const BitVector & rhs) noexcept;
+			///this & ~rhs
+			Result<BitVector &, Error> 	and_not_with(const BitVector & rhs) noexcept;
+
+			BitVector && 						move() noexcept;
+			Result<BitVector<Alloc>, Error> 	copy() const noexcept;
+
+			iterator 	begin() const noexcept;
+			iterator 	end() const noexcept;
+			///range over indices of set bits
+			range 		ones() const noexcept;
+
+			///SizeError if length is greater than max_length
+			static Result<BitVector<Alloc>, Error> make(unsigned length, bool value = false) noexcept;
+		private:
+			static unsigned _find(const word * words, unsigned length, unsigned from) noexcept;
+			template<class Op>
+			Result<BitVector &, Error> _bulk(const BitVector & rhs) noexcept;
+			unsigned _word_count() const noexcept;
+			word * _words() const noexcept;
+			///keeps bits behind length() zero, so count and bulk operations can work on whole words
+			void _clear_tail() noexcept;
+			///slice of allocated words, null when length is 0
+			memory::Slice _mem;
+			unsigned _length;
+			BitVector(memory::Slice && sl, unsigned length) noexcept;
+		};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#pragma region BitVector implementation
+	#pragma region constructors / destructor
+		//move constructor
+		template<class Alloc>
+		BitVector<Alloc>::BitVector(BitVector && b) noexcept :
+			_mem(std::move(b._mem)), _length(b._length)
+		{
+			b._mem = memory::Slice::null();
+			b._length = 0;
+		}
+		//constructor
+		template<class Alloc>
+		BitVector<Alloc>::BitVector(memory::Slice && sl, unsigned length) noexcept :
+			_mem(std::move(sl)), _length(length)
+		{}
+		//destructor
+		template<class Alloc>
+		BitVector<Alloc>::~BitVector() noexcept {
+			if (_mem.begin_as<void>() != nullptr)
+				Alloc::deallocate(std::move(_mem), memory::simd_alignment);//guaranteed to be noexcept by allocator trait
+		}
+	#pragma endregion
+	#pragma region make
+		template<class Alloc>
+		Result<BitVector<Alloc>, Error> BitVector<Alloc>::make(unsigned length, bool value) noexcept {
+			if (length == 0)
+				return Ok(BitVector<Alloc>{ memory::Slice::null(), 0 });
+			if (length > max_length)
+				return Err(Error::SizeError);
+			const unsigned words = (length + word_bits - 1) / word_bits;
+			//simd aligned, so bulk operations do aligned loads
+			return Alloc::allocate(words * sizeof(word), memory::simd_alignment)
+				.template map_result_type<BitVector<Alloc>>([length, value](memory::Slice && sl) {
+					BitVector<Alloc> b{ std::move(sl), length };
+					b.fill(value);
+					return Ok(b.move());
+				})
+			;
+		}
+	#pragma endregion
+	#pragma region container
+		template<class Alloc>
+		typename BitVector<Alloc>::iterator BitVector<Alloc>::begin() const noexcept {
+			return { _words(), _length, _find(_words(), _length, 0) };
+		}
+		template<class Alloc>
+		typename BitVector<Alloc>::iterator BitVector<Alloc>::end() const noexcept {
+			return { _words(), _length, _length };
+		}
+		template<class Alloc>
+		typename BitVector<Alloc>::range BitVector<Alloc>::ones() const noexcept {
+			return { begin(), end() };
+		}
+	#pragma endregion
+	#pragma region methods
+		template<class Alloc>
+		unsigned BitVector<Alloc>::_word_count() const noexcept {
+			return (_length + word_bits - 1) / word_bits;
+		}
+		template<class Alloc>
+		typename BitVector<Alloc>::word * BitVector<Alloc>::_words() const noexcept {
+			return _mem.begin_as<word>();
+		}
+		template<class Alloc>
+		void BitVector<Alloc>::_clear_tail() noexcept {
+			if (_length % word_bits != 0)
+				_words()[_word_count() - 1] &= (word(1) << (_length % word_bits)) - 1;
+		}
+		template<class Alloc>
+		unsigned BitVector<Alloc>::_find(const word * words, unsigned length, unsigned from) noexcept {
+			if (from >= length)
+				return length;
+			unsigned w = from / word_bits;
+			word current = words[w] & (~word(0) << (from % word_bits));
+			const unsigned count = (length + word_bits - 1) / word_bits;
+			while (current == 0) {
+				if (++w == count)
+					return length;
+				current = words[w];
+			}
+			return w * word_bits + detail::_lowest_bit(current);
+		}
+		template<class Alloc>
+		unsigned BitVector<Alloc>::length() const noexcept {
+			return _length;
+		}
+		template<class Alloc>
+		unsigned BitVector<Alloc>::count() const noexcept {
+			unsigned res = 0;
+			const word * words = _words();
+			for (unsigned i = 0, n = _word_count(); i < n; ++i)
+				res += detail::_popcount(words[i]);
+			return res;
+		}
+		template<class Alloc>
+		bool BitVector<Alloc>::empty() const noexcept {
+			return _length == 0;
+		}
+		template<class Alloc>
+		BitVector<Alloc> & BitVector<Alloc>::fill(bool value) noexcept {
+			if (_length != 0) {
+				std::memset(_words(), value ? 0xFF : 0, _word_count() * sizeof(word));
+				_clear_tail();
+			}
+			return *this;
+		}
+		template<class Alloc>
+		bool BitVector<Alloc>::operator == (const BitVector<Alloc> & b) const noexcept {
+			return _length == b._length
+				&& (_length == 0 || std::memcmp(_words(), b._words(), _word_count() * sizeof(word)) == 0);
+		}
+		template<class Alloc>
+		bool BitVector<Alloc>::operator != (const BitVector<Alloc> & b) const noexcept {
+			return !(*this == b);
+		}
+		template<class Alloc>
+		Result<bool, Error> BitVector<Alloc>::at(unsigned index) const noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(bool((_words()[index / word_bits] >> (index % word_bits)) & 1));
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::set(unsigned index, bool value) noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			const word mask = word(1) << (index % word_bits);
+			if (value)
+				_words()[index / word_bits] |= mask;
+			else
+				_words()[index / word_bits] &= ~mask;
+			return Ok(*this);
+		}
+		template<class Alloc>
+		Result<unsigned, Error> BitVector<Alloc>::find_first() const noexcept {
+			const unsigned index = _find(_words(), _length, 0);
+			if (index == _length)
+				return Err(Error::OutOfRange);
+			return Ok(unsigned(index));
+		}
+		template<class Alloc>
+		Result<unsigned, Error> BitVector<Alloc>::find_next(unsigned from) const noexcept {
+			if (from >= _length)
+				return Err(Error::OutOfRange);
+			const unsigned index = _find(_words(), _length, from + 1);
+			if (index == _length)
+				return Err(Error::OutOfRange);
+			return Ok(unsigned(index));
+		}
+		template<class Alloc>
+		template<class Op>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::_bulk(const BitVector<Alloc> & b) noexcept {
+			if (_length != b._length)
+				return Err(Error::SizeError);
+			word * dst = _words();
+			const word * src = b._words();
+			const unsigned n = _word_count();
+			unsigned i = 0;
+#if defined(__AVX2__)
+			//both buffers are simd aligned, 4 words per step
+			for (; i + 4 <= n; i += 4) {
+				const __m256i x = _mm256_load_si256(reinterpret_cast<const __m256i *>(dst + i));
+				const __m256i y = _mm256_load_si256(reinterpret_cast<const __m256i *>(src + i));
+				_mm256_store_si256(reinterpret_cast<__m256i *>(dst + i), Op::apply(x, y));
+			}
+#endif
+			for (; i < n; ++i)
+				dst[i] = Op::apply(dst[i], src[i]);
+			return Ok(*this);
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::and_with(const BitVector<Alloc> & b) noexcept {
+			return _bulk<detail::_And>(b);
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::or_with(const BitVector<Alloc> & b) noexcept {
+			return _bulk<detail::_Or>(b);
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::xor_with(const BitVector<Alloc> & b) noexcept {
+			return _bulk<detail::_Xor>(b);
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc> &, Error> BitVector<Alloc>::and_not_with(const BitVector<Alloc> & b) noexcept {
+			return _bulk<detail::_AndNot>(b);
+		}
+		template<class Alloc>
+		BitVector<Alloc> && BitVector<Alloc>::move() noexcept {
+			return std::move(*this);
+		}
+		template<class Alloc>
+		Result<BitVector<Alloc>, Error> BitVector<Alloc>::copy() const noexcept {
+			return make(_length)
+				.template map_result_type<BitVector<Alloc>>([this](BitVector<Alloc> && b) {
+					if (_length != 0)
+						std::memcpy(b._words(), _words(), _word_count() * sizeof(word));
+					return Ok(b.move());
+				})
+			;
+		}
+	#pragma endregion
+#pragma endregion
+	}
+}
\ No newline at end of file
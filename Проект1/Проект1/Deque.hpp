@@ -0,0 +1,373 @@
+#pragma once
+#include <new>
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+
+namespace gc {
+	namespace container {
+		///growable double-ended queue of fixed-size blocks, elements are never relocated on push
+		template<class T, class Alloc = gc::memory::Allocator>
+		class Deque : INonCopyable {
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"second template argument do not match gc_allocator trait");
+		public:
+			///elements per block, block is about 4KB unless T is big
+			static constexpr unsigned block_length = sizeof(T) <= 256 ? 4096 / sizeof(T) : 16;
+
+			class iterator {
+				///slot in the block map, map always keeps nullptr slot behind the last block
+				T ** _node;
+				T * _cur;
+			public:
+				iterator(T ** node, T * cur) noexcept :
+					_node(node), _cur(cur)
+				{}
+				T & operator * () const noexcept { return *_cur; }
+				T * operator -> () const noexcept { return _cur; }
+				iterator & operator ++ () noexcept {
+					if (++_cur == *_node + block_length) {
+						++_node;
+						_cur = *_node;
+					}
+					return *this;
+				}
+				bool operator < (const iterator & rhs) const noexcept {
+					return _node < rhs._node || (_node == rhs._node && _cur < rhs._cur);
+				}
+				bool operator == (const iterator & rhs) const noexcept { return _node == rhs._node && _cur == rhs._cur; }
+				bool operator != (const iterator & rhs) const noexcept { return !(*this == rhs); }
+			};
+			//container
+			using range = Range<iterator>;
+
+			Deque(Deque && d) noexcept;
+			~Deque() noexcept;
+
+			unsigned 	length() const noexcept;
+			bool 		empty() const noexcept;
+			Deque & 	clear() noexcept;
+			template<class ... Args>
+			Result<T *, Error> push_back(Args && ... ctor_args) noexcept;
+			template<class ... Args>
+			Result<T *, Error> push_front(Args && ... ctor_args) noexcept;
+			Result<T, Error> 	pop_back() noexcept;
+			Result<T, Error> 	pop_front() noexcept;
+
+			Result<T &, Error> 			at(unsigned index) noexcept;
+			Result<const T &, Error> 	at(unsigned index) const noexcept;
+			Result<T &, Error>			front() noexcept;
+			Result<const T &, Error>	front() const noexcept;
+			Result<T &, Error>			back() noexcept;
+			Result<const T &, Error>	back() const noexcept;
+
+			Deque && 	move() noexcept;
+
+			iterator 	begin() noexcept;
+			iterator 	end() noexcept;
+			range 		whole() noexcept;
+			Result<range, Error> window(unsigned from, unsigned count) noexcept;
+
+			static Deque<T, Alloc> make() noexcept;
+		private:
+			T ** _nodes() const noexcept;
+			unsigned _map_capacity() const noexcept;
+			iterator _iterator_at(unsigned index) noexcept;
+			///new block for push_back()/push_front() once the last/first block is full
+			Result<T *, Error> _slot_back() noexcept;
+			Result<T *, Error> _slot_front() noexcept;
+			Result<T **, Error> _grow_map(unsigned front_room) noexcept;
+			void _release_block(T ** node) noexcept;
+			///block map: array of T * pointing to blocks of block_length elements
+			memory::Slice _map;
+			///index of the first used slot in the map
+			unsigned _first_node;
+			unsigned _node_count;
+			///index of the first element inside the first block
+			unsigned _offset;
+			unsigned _length;
+			Deque(memory::Slice && map) noexcept;
+		};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#pragma region Deque implementation
+	#pragma region constructors / destructor
+		//move constructor
+		template<class T, class Alloc>
+		Deque<T, Alloc>::Deque(Deque && d) noexcept :
+			_map(std::move(d._map)), _first_node(d._first_node), _node_count(d._node_count),
+			_offset(d._offset), _length(d._length)
+		{
+			d._map = memory::Slice::null();
+			d._first_node = d._node_count = d._offset = d._length = 0;
+		}
+		//constructor
+		template<class T, class Alloc>
+		Deque<T, Alloc>::Deque(memory::Slice && map) noexcept :
+			_map(std::move(map)), _first_node(0), _node_count(0), _offset(0), _length(0)
+		{}
+		//destructor
+		template<class T, class Alloc>
+		Deque<T, Alloc>::~Deque() noexcept {
+			static_assert(std::is_nothrow_destructible_v<T>,
+				"gc::container::Deque<T, Alloc> T destructor must be noexcept");
+
+			if (_map.begin_as<void>() != nullptr) {
+				clear();
+				Alloc::deallocate(std::move(_map), alignof(T *));//guaranteed to be noexcept by allocator trait
+			}
+		}
+	#pragma endregion
+	#pragma region make
+		template<class T, class Alloc>
+		Deque<T, Alloc> Deque<T, Alloc>::make() noexcept {
+			return { memory::Slice::null() };
+		}
+	#pragma endregion
+	#pragma region container
+		template<class T, class Alloc>
+		typename Deque<T, Alloc>::iterator Deque<T, Alloc>::_iterator_at(unsigned index) noexcept {
+			if (_node_count == 0)
+				return { nullptr, nullptr };
+			const unsigned pos = _offset + index;
+			T ** node = _nodes() + _first_node + pos / block_length;
+			return { node, *node + pos % block_length };
+		}
+		template<class T, class Alloc>
+		typename Deque<T, Alloc>::iterator Deque<T, Alloc>::begin() noexcept {
+			return _iterator_at(0);
+		}
+		template<class T, class Alloc>
+		typename Deque<T, Alloc>::iterator Deque<T, Alloc>::end() noexcept {
+			return _iterator_at(_length);
+		}
+		template<class T, class Alloc>
+		typename Deque<T, Alloc>::range Deque<T, Alloc>::whole() noexcept {
+			return { begin(), end() };
+		}
+		template<class T, class Alloc>
+		Result<typename Deque<T, Alloc>::range, Error> Deque<T, Alloc>::window(unsigned from, unsigned count) noexcept {
+			if (from > _length || count > _length - from)
+				return Err(Error::OutOfRange);
+			return Ok(range{ _iterator_at(from), _iterator_at(from + count) });
+		}
+	#pragma endregion
+	#pragma region accessors
+		template<class T, class Alloc>
+		Result<T &, Error> Deque<T, Alloc>::at(unsigned index) noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(*_iterator_at(index));
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> Deque<T, Alloc>::at(unsigned index) const noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(static_cast<const T &>(*const_cast<Deque *>(this)->_iterator_at(index)));
+		}
+		template<class T, class Alloc>
+		Result<T &, Error> Deque<T, Alloc>::front() noexcept {
+			return at(0);
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> Deque<T, Alloc>::front() const noexcept {
+			return at(0);
+		}
+		template<class T, class Alloc>
+		Result<T &, Error> Deque<T, Alloc>::back() noexcept {
+			return at(_length - 1);//wraps to UINT_MAX when empty, so at() reports OutOfRange
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> Deque<T, Alloc>::back() const noexcept {
+			return at(_length - 1);
+		}
+	#pragma endregion
+	#pragma region methods
+		template<class T, class Alloc>
+		unsigned Deque<T, Alloc>::length() const noexcept {
+			return _length;
+		}
+		template<class T, class Alloc>
+		bool Deque<T, Alloc>::empty() const noexcept {
+			return _length == 0;
+		}
+		template<class T, class Alloc>
+		Deque<T, Alloc> & Deque<T, Alloc>::clear() noexcept {
+			for (auto i = begin(), e = end(); i != e; ++i)
+				i->~T();
+			for (unsigned i = 0; i < _node_count; ++i)
+				_release_block(_nodes() + _first_node + i);
+			_first_node = _map_capacity() / 2;
+			_node_count = _offset = _length = 0;
+			return *this;
+		}
+		template<class T, class Alloc>
+		template<class ... Args>
+		Result<T *, Error> Deque<T, Alloc>::push_back(Args && ... ctor_args) noexcept {
+			static_assert(std::is_nothrow_constructible<T, Args && ...>::value,
+				"gc::container::Deque<T>::push_back(args...) T must be nothrow constructible with args");
+			//room in the last block: no allocation, so skip the Result round trip through _slot_back()
+			const unsigned pos = _offset + _length;
+			if (pos < _node_count * block_length) {
+				T * ptr = _nodes()[_first_node + pos / block_length] + pos % block_length;
+				new(ptr) T(std::forward<Args>(ctor_args)...);//asserted to be noexcept
+				++_length;
+				return Ok(std::move(ptr));
+			}
+			return _slot_back()
+				.on_success([&](T * && ptr) {
+					new(ptr) T(std::forward<Args>(ctor_args)...);//asserted to be noexcept
+					++_length;
+					return Ok(std::move(ptr));
+				})
+				.move();
+		}
+		template<class T, class Alloc>
+		template<class ... Args>
+		Result<T *, Error> Deque<T, Alloc>::push_front(Args && ... ctor_args) noexcept {
+			static_assert(std::is_nothrow_constructible<T, Args && ...>::value,
+				"gc::container::Deque<T>::push_front(args...) T must be nothrow constructible with args");
+			if (_offset > 0) {
+				T * ptr = _nodes()[_first_node] + --_offset;
+				new(ptr) T(std::forward<Args>(ctor_args)...);//asserted to be noexcept
+				++_length;
+				return Ok(std::move(ptr));
+			}
+			return _slot_front()
+				.on_success([&](T * && ptr) {
+					new(ptr) T(std::forward<Args>(ctor_args)...);//asserted to be noexcept
+					--_offset;
+					++_length;
+					return Ok(std::move(ptr));
+				})
+				.move();
+		}
+		template<class T, class Alloc>
+		Result<T, Error> Deque<T, Alloc>::pop_back() noexcept {
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"gc::container::Deque<T>::pop_back() requires nothrow move constructible T");
+			if (empty())
+				return Err(Error::UnderflowError);
+			T * ptr = &*_iterator_at(_length - 1);
+			Result<T, Error> res = Ok(std::move(*ptr));
+			ptr->~T();
+			--_length;
+			//drop the last block once nothing lives in it
+			if (_offset + _length <= (_node_count - 1) * block_length) {
+				_release_block(_nodes() + _first_node + --_node_count);
+				if (_node_count == 0)
+					_offset = 0;
+			}
+			return res;
+		}
+		template<class T, class Alloc>
+		Result<T, Error> Deque<T, Alloc>::pop_front() noexcept {
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"gc::container::Deque<T>::pop_front() requires nothrow move constructible T");
+			if (empty())
+				return Err(Error::UnderflowError);
+			T * ptr = _nodes()[_first_node] + _offset;
+			Result<T, Error> res = Ok(std::move(*ptr));
+			ptr->~T();
+			--_length;
+			if (++_offset == block_length || _length == 0) {
+				_release_block(_nodes() + _first_node);
+				++_first_node;
+				--_node_count;
+				_offset = 0;
+			}
+			return res;
+		}
+		template<class T, class Alloc>
+		Deque<T, Alloc> && Deque<T, Alloc>::move() noexcept {
+			return std::move(*this);
+		}
+	#pragma endregion
+	#pragma region block map
+		template<class T, class Alloc>
+		T ** Deque<T, Alloc>::_nodes() const noexcept {
+			return _map.begin_as<T *>();
+		}
+		template<class T, class Alloc>
+		unsigned Deque<T, Alloc>::_map_capacity() const noexcept {
+			return _map.end_as<T *>() - _map.begin_as<T *>();
+		}
+		template<class T, class Alloc>
+		void Deque<T, Alloc>::_release_block(T ** node) noexcept {
+			Alloc::deallocate(memory::Slice::make(*node, sizeof(T) * block_length), alignof(T));
+			*node = nullptr;
+		}
+		///reallocates the map only (never the blocks), leaving at least front_room free slots before the first block
+		template<class T, class Alloc>
+		Result<T **, Error> Deque<T, Alloc>::_grow_map(unsigned front_room) noexcept {
+			const unsigned capacity = (_node_count + 1) * 2 + front_room + 4;
+			auto res = Alloc::allocate(sizeof(T *) * capacity, alignof(T *));
+			if (res.is_err())
+				return res.forward_error();
+			memory::Slice map = res.unwrap_value();
+			T ** nodes = map.begin_as<T *>();
+			const unsigned first = (capacity - _node_count) / 2 > front_room ? (capacity - _node_count) / 2 : front_room;
+			for (unsigned i = 0; i < capacity; ++i)
+				nodes[i] = nullptr;
+			for (unsigned i = 0; i < _node_count; ++i)
+				nodes[first + i] = _nodes()[_first_node + i];
+			if (_map.begin_as<void>() != nullptr)
+				Alloc::deallocate(std::move(_map), alignof(T *));
+			_map = map.move();
+			_first_node = first;
+			return Ok(std::move(nodes));
+		}
+		template<class T, class Alloc>
+		Result<T *, Error> Deque<T, Alloc>::_slot_back() noexcept {
+			//one more block at the back, map keeps a trailing nullptr slot for end()
+			if (_first_node + _node_count + 2 > _map_capacity()) {
+				auto grown = _grow_map(0);
+				if (grown.is_err())
+					return grown.forward_error();
+			}
+			return Alloc::allocate(sizeof(T) * block_length, alignof(T))
+				.template map_result_type<T *>([this](memory::Slice && sl) {
+					T * block = sl.begin_as<T>();
+					_nodes()[_first_node + _node_count++] = block;
+					return Ok(std::move(block));
+				});
+		}
+		template<class T, class Alloc>
+		Result<T *, Error> Deque<T, Alloc>::_slot_front() noexcept {
+			if (_first_node == 0 || _map_capacity() == 0) {
+				auto grown = _grow_map(1);
+				if (grown.is_err())
+					return grown.forward_error();
+			}
+			return Alloc::allocate(sizeof(T) * block_length, alignof(T))
+				.template map_result_type<T *>([this](memory::Slice && sl) {
+					T * block = sl.begin_as<T>();
+					_nodes()[--_first_node] = block;
+					++_node_count;
+					_offset = block_length;
+					return Ok(block + block_length - 1);
+				});
+		}
+	#pragma endregion
+#pragma endregion
+	}
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+#endif
+
+#include "Result.hpp"
+#include "Memory.hpp"
+#include "Allocator.hpp"
+
+namespace gc {
+	namespace memory {
+		///maps large buffers with huge pages to cut TLB misses, falls back to normal pages
+		///(with transparent huge page hint on linux) if the system has no huge pages reserved
+		///every allocation takes whole huge pages, so use it only for big long-lived buffers
+		class HugePageAllocator {
+		public:
+			static constexpr unsigned huge_page_size = 2u << 20;
+			///mapping is page aligned, bigger alignment is rejected
+			static constexpr unsigned max_alignment = 4096;
+
+			static gc::Result<Slice, gc::Error> allocate(unsigned int size, unsigned int alignment) noexcept {
+				if (!is_valid_alignment(alignment) || alignment > max_alignment)
+					return gc::Err(gc::Error::InvalidArgument);
+				if (size == 0)
+					return gc::Ok(Slice::null());
+				void * res = _map(_mapped_length(size));
+				if (!res)
+					return gc::Err(gc::Error::BadAlloc);
+				return gc::Ok(Slice::make(res, size));
+			}
+			static void deallocate(Slice && slice, unsigned int) noexcept {
+				if (slice.begin_as<void>() == nullptr)
+					return;
+#ifdef _WIN32
+				VirtualFree(slice.begin_as<void>(), 0, MEM_RELEASE);
+#else
+				munmap(slice.begin_as<void>(), _mapped_length(slice.size()));
+#endif
+			}
+		private:
+			static std::size_t _mapped_length(unsigned size) noexcept {
+				return (std::size_t(size) + huge_page_size - 1) / huge_page_size * huge_page_size;
+			}
+			static void * _map(std::size_t length) noexcept {
+#ifdef _WIN32
+				//large pages need SeLockMemoryPrivilege, without it VirtualAlloc fails and normal pages are used
+				const SIZE_T large_page = GetLargePageMinimum();
+				if (large_page != 0 && length % large_page == 0)
+					if (void * res = VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE))
+						return res;
+				return VirtualAlloc(nullptr, length, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+	#ifdef MAP_HUGETLB
+				void * res = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+				if (res != MAP_FAILED)
+					return res;
+	#endif
+				//map one huge page more, so the buffer can start on huge page boundary where THP can back it
+				char * raw = static_cast<char *>(mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+				if (raw == MAP_FAILED)
+					return nullptr;
+				const std::size_t head = (huge_page_size - reinterpret_cast<std::size_t>(raw) % huge_page_size) % huge_page_size;
+				if (head != 0)
+					munmap(raw, head);
+				munmap(raw + head + length, huge_page_size - head);
+	#ifdef MADV_HUGEPAGE
+				madvise(raw + head, length, MADV_HUGEPAGE);
+	#endif
+				return raw + head;
+#endif
+			}
+		};
+	}
+}
\ No newline at end of file
@@ -77,24 +77,19 @@ namespace gc {
 		};
 	}
 	namespace traits {
+		///allocate(size, alignment) must return memory aligned to alignment (power of two),
+		///deallocate(slice, alignment) receives the same alignment which was passed to allocate
+		template<class T>
+		concept gc_allocator = requires(unsigned int size, unsigned int alignment, memory::Slice && slice) {
+			{ T::allocate(size, alignment) } noexcept -> std::same_as<Result<memory::Slice, Error>>;	//if allocate(size, alignment) return result
+			{ T::deallocate(std::move(slice), alignment) } noexcept -> std::same_as<void>;			//if deallocate(slice, alignment) return void
+		};
 		template<class T>
 		class is_gc_allocator {
-			struct detecter {};
-
-			static constexpr detecter detection(...) {}
-			template<class Y>
-			static constexpr 
-			typename std::enable_if<
-				   std::is_same_v<decltype(Y::allocate(std::declval<unsigned int>())), Result<memory::Slice, Error>>//if allocate return result
-				&& std::is_same_v<decltype(Y::deallocate(std::declval<gc::memory::Slice &&>())), void> 				//if deallocate return void
-				&& noexcept(Y::allocate(std::declval<unsigned>()))													//if allocate is noexcept
-				&& noexcept(Y::deallocate(std::declval<gc::memory::Slice>()))										//if deallocate is noexcept
-				, void>::type
-			detection(Y &&) {}
 		public:
-			static constexpr bool value = !std::is_same_v<decltype(detection(std::declval<T>())), detecter>;
+			static constexpr bool value = gc_allocator<T>;
 		};
 		template<class T>
-		constexpr bool is_gc_allocator_v = is_gc_allocator<T>::value;
+		constexpr bool is_gc_allocator_v = gc_allocator<T>;
 	}
 }
\ No newline at end of file
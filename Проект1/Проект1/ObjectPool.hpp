@@ -0,0 +1,357 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+
+namespace gc {
+	namespace container {
+		///objects live in fixed chunks and never move, so pointers and handles stay valid until release
+		///acquire/release are O(1): free slots form an intrusive list, iteration walks the chunks and skips free slots
+		template<class T, class Alloc = gc::memory::Allocator>
+		class ObjectPool : INonCopyable {
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"second template argument do not match gc_allocator trait");
+
+			struct _Slot {
+				union {
+					alignas(T) unsigned char storage[sizeof(T)];
+					///next free slot while the slot is free, shares the bytes of the released object
+					_Slot * next_free;
+				};
+				///odd while the slot holds an object, bumped on every acquire and release
+				unsigned generation;
+				T * value() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+			};
+		public:
+			///slots per chunk, chunk is about 4KB unless T is big
+			static constexpr unsigned chunk_length = sizeof(_Slot) <= 256 ? 4096 / sizeof(_Slot) : 16;
+
+			///refers to one object of the pool, becomes stale once the object is released
+			///must not outlive the pool, it points into pool memory
+			class Handle {
+				friend class ObjectPool;
+				_Slot * _slot;
+				unsigned _generation;
+				///id of the pool that made the handle, lets release() reject handles of other pools
+				unsigned _pool;
+				Handle(_Slot * slot, unsigned generation, unsigned pool) noexcept :
+					_slot(slot), _generation(generation), _pool(pool)
+				{}
+			public:
+				Handle() noexcept :
+					_slot(nullptr), _generation(0), _pool(0)
+				{}
+				bool alive() const noexcept {
+					return _slot != nullptr && _slot->generation == _generation;
+				}
+				///OutOfRange - handle is empty or its object was released
+				Result<T &, Error> get() const noexcept {
+					if (!alive())
+						return Err(Error::OutOfRange);
+					return Ok(*_slot->value());
+				}
+				bool operator == (const Handle & rhs) const noexcept { return _slot == rhs._slot && _generation == rhs._generation; }
+				bool operator != (const Handle & rhs) const noexcept { return !(*this == rhs); }
+			};
+			///walks live objects only, chunk by chunk in address order
+			class iterator {
+				friend class ObjectPool;
+				///slot in the chunk list, chunk list always keeps nullptr slot behind the last chunk
+				_Slot ** _chunk;
+				_Slot * _cur;
+				unsigned _pool;
+				iterator(_Slot ** chunk, _Slot * cur, unsigned pool) noexcept :
+					_chunk(chunk), _cur(cur), _pool(pool)
+				{}
+				///moves forward to the first slot holding an object, or to end
+				void _skip_free() noexcept {
+					while (_cur != nullptr && (_cur->generation & 1) == 0)
+						if (++_cur == *_chunk + chunk_length) {
+							++_chunk;
+							_cur = *_chunk;
+						}
+				}
+			public:
+				T & operator * () const noexcept { return *_cur->value(); }
+				T * operator -> () const noexcept { return _cur->value(); }
+				iterator & operator ++ () noexcept {
+					if (++_cur == *_chunk + chunk_length) {
+						++_chunk;
+						_cur = *_chunk;
+					}
+					_skip_free();
+					return *this;
+				}
+				Handle handle() const noexcept { return { _cur, _cur->generation, _pool }; }
+				bool operator < (const iterator & rhs) const noexcept {
+					return _chunk < rhs._chunk || (_chunk == rhs._chunk && _cur < rhs._cur);
+				}
+				bool operator == (const iterator & rhs) const noexcept { return _chunk == rhs._chunk && _cur == rhs._cur; }
+				bool operator != (const iterator & rhs) const noexcept { return !(*this == rhs); }
+			};
+			//container
+			using range = Range<iterator>;
+
+			ObjectPool(ObjectPool && p) noexcept;
+			~ObjectPool() noexcept;
+
+			unsigned 	length() const noexcept;
+			unsigned 	capacity() const noexcept;
+			bool 		empty() const noexcept;
+			ObjectPool & clear() noexcept;
+			Result<ObjectPool &, Error> reserve(unsigned capacity) noexcept;
+			template<class ... Args>
+			Result<Handle, Error> acquire(Args && ... ctor_args) noexcept;
+			///OutOfRange - handle is stale or was not acquired from this pool
+			Result<ObjectPool &, Error> release(const Handle & handle) noexcept;
+
+			ObjectPool && move() noexcept;
+
+			///releasing the object under an iterator invalidates it, acquiring invalidates iterators when the pool grows
+			iterator 	begin() noexcept;
+			iterator 	end() noexcept;
+			range 		whole() noexcept;
+
+			static ObjectPool<T, Alloc> make() noexcept;
+			static Result<ObjectPool<T, Alloc>, Error> make_with_capacity(unsigned capacity) noexcept;
+		private:
+			///largest chunk count, for which capacity() still fits into unsigned, with room for the trailing nullptr
+			static constexpr unsigned _max_chunks = unsigned(-1) / chunk_length - 1;
+
+			///unique per pool, 0 is never used, so default Handle belongs to no pool
+			static unsigned _next_id() noexcept;
+			_Slot ** _chunk_list() const noexcept;
+			unsigned _chunk_capacity() const noexcept;
+			Result<_Slot **, Error> _grow_chunk_list() noexcept;
+			Result<_Slot *, Error> _add_chunk() noexcept;
+			///array of _Slot * pointing to chunks of chunk_length slots, followed by nullptr
+			memory::Slice _chunks;
+			unsigned _chunk_count;
+			unsigned _length;
+			unsigned _id;
+			_Slot * _free;
+			ObjectPool() noexcept;
+		};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#pragma region ObjectPool implementation
+	#pragma region constructors / destructor
+		//constructor
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc>::ObjectPool() noexcept :
+			_chunks(memory::Slice::null()), _chunk_count(0), _length(0), _id(_next_id()), _free(nullptr)
+		{}
+		//move constructor
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc>::ObjectPool(ObjectPool && p) noexcept :
+			_chunks(std::move(p._chunks)),
+			_chunk_count(p._chunk_count), _length(p._length), _id(p._id), _free(p._free)
+		{
+			p._chunks = memory::Slice::null();
+			p._chunk_count = p._length = 0;
+			//handles made by p now belong to this pool, p may still be reused
+			p._id = _next_id();
+			p._free = nullptr;
+		}
+		//destructor
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc>::~ObjectPool() noexcept {
+			static_assert(std::is_nothrow_destructible_v<T>,
+				"gc::container::ObjectPool<T, Alloc> T destructor must be noexcept");
+
+			if constexpr (!std::is_trivially_destructible_v<T>)
+				for (T & t : *this)
+					t.~T();
+			for (unsigned i = 0; i < _chunk_count; ++i)
+				Alloc::deallocate(memory::Slice::make(_chunk_list()[i], sizeof(_Slot) * chunk_length), alignof(_Slot));//guaranteed to be noexcept by allocator trait
+			if (_chunks.begin_as<void>() != nullptr)
+				Alloc::deallocate(std::move(_chunks), alignof(_Slot *));
+		}
+	#pragma endregion
+	#pragma region make
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc> ObjectPool<T, Alloc>::make() noexcept {
+			return {};
+		}
+		template<class T, class Alloc>
+		Result<ObjectPool<T, Alloc>, Error> ObjectPool<T, Alloc>::make_with_capacity(unsigned capacity) noexcept {
+			ObjectPool<T, Alloc> p;
+			auto res = p.reserve(capacity);
+			if (res.is_err())
+				return res.forward_error();
+			return Ok(p.move());
+		}
+	#pragma endregion
+	#pragma region container
+		template<class T, class Alloc>
+		typename ObjectPool<T, Alloc>::iterator ObjectPool<T, Alloc>::begin() noexcept {
+			if (_chunk_count == 0)
+				return { nullptr, nullptr, _id };
+			iterator i{ _chunk_list(), *_chunk_list(), _id };
+			i._skip_free();
+			return i;
+		}
+		template<class T, class Alloc>
+		typename ObjectPool<T, Alloc>::iterator ObjectPool<T, Alloc>::end() noexcept {
+			if (_chunk_count == 0)
+				return { nullptr, nullptr, _id };
+			return { _chunk_list() + _chunk_count, nullptr, _id };
+		}
+		template<class T, class Alloc>
+		typename ObjectPool<T, Alloc>::range ObjectPool<T, Alloc>::whole() noexcept {
+			return { begin(), end() };
+		}
+	#pragma endregion
+	#pragma region methods
+		template<class T, class Alloc>
+		unsigned ObjectPool<T, Alloc>::length() const noexcept {
+			return _length;
+		}
+		template<class T, class Alloc>
+		unsigned ObjectPool<T, Alloc>::capacity() const noexcept {
+			return _chunk_count * chunk_length;
+		}
+		template<class T, class Alloc>
+		bool ObjectPool<T, Alloc>::empty() const noexcept {
+			return _length == 0;
+		}
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc> & ObjectPool<T, Alloc>::clear() noexcept {
+			//free list is rebuilt in address order, as after _add_chunk()
+			_free = nullptr;
+			for (unsigned c = _chunk_count; c-- > 0;)
+				for (unsigned i = chunk_length; i-- > 0;) {
+					_Slot * slot = _chunk_list()[c] + i;
+					if (slot->generation & 1) {
+						slot->value()->~T();
+						++slot->generation;
+					}
+					slot->next_free = _free;
+					_free = slot;
+				}
+			_length = 0;
+			return *this;
+		}
+		template<class T, class Alloc>
+		Result<ObjectPool<T, Alloc> &, Error> ObjectPool<T, Alloc>::reserve(unsigned capacity) noexcept {
+			while (this->capacity() < capacity) {
+				auto res = _add_chunk();
+				if (res.is_err())
+					return res.forward_error();
+			}
+			return Ok(*this);
+		}
+		template<class T, class Alloc>
+		template<class ... Args>
+		Result<typename ObjectPool<T, Alloc>::Handle, Error> ObjectPool<T, Alloc>::acquire(Args && ... ctor_args) noexcept {
+			static_assert(std::is_nothrow_constructible<T, Args && ...>::value,
+				"gc::container::ObjectPool<T>::acquire(args...) T must be nothrow constructible with args");
+			if (_free == nullptr) {
+				auto res = _add_chunk();
+				if (res.is_err())
+					return res.forward_error();
+			}
+			_Slot * slot = _free;
+			_free = slot->next_free;
+			new(slot->storage) T(std::forward<Args>(ctor_args)...);//asserted to be noexcept
+			++slot->generation;
+			++_length;
+			return Ok(Handle{ slot, slot->generation, _id });
+		}
+		template<class T, class Alloc>
+		Result<ObjectPool<T, Alloc> &, Error> ObjectPool<T, Alloc>::release(const Handle & handle) noexcept {
+			_Slot * slot = handle._slot;
+			if (!handle.alive() || handle._pool != _id)
+				return Err(Error::OutOfRange);
+			slot->value()->~T();
+			++slot->generation;
+			--_length;
+			slot->next_free = _free;
+			_free = slot;
+			return Ok(*this);
+		}
+		template<class T, class Alloc>
+		ObjectPool<T, Alloc> && ObjectPool<T, Alloc>::move() noexcept {
+			return std::move(*this);
+		}
+	#pragma endregion
+	#pragma region chunks
+		template<class T, class Alloc>
+		unsigned ObjectPool<T, Alloc>::_next_id() noexcept {
+			static std::atomic<unsigned> last{ 0 };
+			return last.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+		template<class T, class Alloc>
+		typename ObjectPool<T, Alloc>::_Slot ** ObjectPool<T, Alloc>::_chunk_list() const noexcept {
+			return _chunks.begin_as<_Slot *>();
+		}
+		template<class T, class Alloc>
+		unsigned ObjectPool<T, Alloc>::_chunk_capacity() const noexcept {
+			return _chunks.end_as<_Slot *>() - _chunks.begin_as<_Slot *>();
+		}
+		///doubles the chunk list, chunks themselves are never moved
+		template<class T, class Alloc>
+		Result<typename ObjectPool<T, Alloc>::_Slot **, Error> ObjectPool<T, Alloc>::_grow_chunk_list() noexcept {
+			if (_chunk_count == _max_chunks)
+				return Err(Error::OverflowError);
+			const unsigned capacity = _chunk_count == 0 ? 4 : (_chunk_count > _max_chunks / 2 ? _max_chunks : _chunk_count * 2);
+			auto res = Alloc::allocate(sizeof(_Slot *) * (capacity + 1), alignof(_Slot *));
+			if (res.is_err())
+				return res.forward_error();
+			memory::Slice chunks = res.unwrap_value();
+			_Slot ** list = chunks.begin_as<_Slot *>();
+			for (unsigned i = 0; i <= capacity; ++i)
+				list[i] = i < _chunk_count ? _chunk_list()[i] : nullptr;
+			if (_chunks.begin_as<void>() != nullptr)
+				Alloc::deallocate(std::move(_chunks), alignof(_Slot *));
+			_chunks = chunks.move();
+			return Ok(std::move(list));
+		}
+		///allocates one more chunk and puts its slots on the free list
+		template<class T, class Alloc>
+		Result<typename ObjectPool<T, Alloc>::_Slot *, Error> ObjectPool<T, Alloc>::_add_chunk() noexcept {
+			if (_chunk_count + 1 >= _chunk_capacity()) {
+				auto grown = _grow_chunk_list();
+				if (grown.is_err())
+					return grown.forward_error();
+			}
+			return Alloc::allocate(sizeof(_Slot) * chunk_length, alignof(_Slot))
+				.template map_result_type<_Slot *>([this](memory::Slice && sl) {
+					_Slot * chunk = sl.begin_as<_Slot>();
+					//linked back to front, so slots are handed out in address order
+					for (unsigned i = chunk_length; i-- > 0;) {
+						_Slot * slot = new(chunk + i) _Slot;
+						slot->generation = 0;
+						slot->next_free = _free;
+						_free = slot;
+					}
+					_chunk_list()[_chunk_count++] = chunk;
+					return Ok(std::move(chunk));
+				});
+		}
+	#pragma endregion
+#pragma endregion
+	}
+}
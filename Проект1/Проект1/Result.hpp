@@ -1,5 +1,9 @@
 #pragma once
 #include <variant>
+#include <functional>
+#ifdef GC_ERROR_TELEMETRY
+	#include <source_location>
+#endif
 
 #include "Traits.hpp"
 
@@ -18,6 +22,24 @@ namespace gc {
 		InsufficientRights,
 		UnknownError
 	};
+#ifdef GC_ERROR_TELEMETRY
+	//opt-in: every gc::Err(gc::Error) is counted per kind and per call site, see Telemetry.hpp
+	//must be defined for the whole program, otherwise gc::Err differs between translation units
+	#if defined(_MSC_VER)
+		#define GC_COLD __declspec(noinline)
+	#else
+		#define GC_COLD [[gnu::cold, gnu::noinline]]
+	#endif
+	template<class T, class E>
+	class Result;
+	namespace telemetry {
+		namespace detail {
+			///template only to be defined in header without inline, which contradicts noinline
+			template<class = void>
+			GC_COLD void _record(Error error, std::source_location location) noexcept;
+		}
+	}
+#endif
 #pragma region ok, err
 	namespace detail {
 		template<class T>
@@ -29,6 +51,12 @@ namespace gc {
 			{}
 		};
 		template<class T>
+		struct _Ok<T &> {
+			T & _data;
+			explicit _Ok(T & t) :_data(t)
+			{}
+		};
+		template<class T>
 		struct _Err {
 			static_assert(!std::is_reference_v<T>,
 				"gc::detail::_Err<T> cannot contain reference as T");
@@ -36,32 +64,68 @@ namespace gc {
 			explicit _Err(T && t) :_data(std::forward<T>(t))
 			{}
 		};
+#ifdef GC_ERROR_TELEMETRY
+		///gc::Err(gc::Error) with its call site, recorded when it is converted to Result
+		///the conversion is out of line and returns the Result itself, so on the caller side the error path
+		///is only a call from a cold block and the ok path keeps the same code as without telemetry
+		struct _TracedErr {
+			Error _data;
+			std::source_location _location;
+			template<class T>
+			GC_COLD operator Result<T, Error>() && noexcept;
+		};
+#endif
 	}
 	template<class T>
 	detail::_Ok<T> Ok(T && t) {
 		static_assert(std::is_nothrow_move_constructible<T>::value,
 			"gc::Ok<T> requires nothrow move constructor for T");
-		return detail::_Ok<T>{ std::move(t) };
+		if constexpr (std::is_lvalue_reference_v<T>)
+			return detail::_Ok<T>{ t };//lvalue is stored by reference, used by accessors
+		else
+			return detail::_Ok<T>{ std::move(t) };
 	}
+#ifdef GC_ERROR_TELEMETRY
+	template<class T>
+	auto Err(T && t, std::source_location location = std::source_location::current()) {
+		static_assert(std::is_nothrow_move_constructible<T>::value,
+			"gc::Err<T> requires nothrow move constructor for T");
+		if constexpr (std::is_same_v<T, Error>)
+			return detail::_TracedErr{ t, location };
+		else
+			return detail::_Err<T>{ std::move(t) };
+	}
+#else
 	template<class T>
 	detail::_Err<T> Err(T && t) { 
 		static_assert(std::is_nothrow_move_constructible<T>::value,
 			"gc::Err<T> requires nothrow move constructor for T");
 		return detail::_Err<T>{ std::move(t) };
 	}
+#endif
 #pragma endregion
 	template<class T, class E>
 	class Result : INonCopyable {
-		static_assert(!std::is_reference_v<T>,
-			"gc::Result<T, E> cannot contain reference as T");
+		static_assert(!std::is_rvalue_reference_v<T>,
+			"gc::Result<T, E> cannot contain rvalue reference as T");
 		static_assert(!std::is_reference_v<E>,
 			"gc::Result<T, E> cannot contain reference as E");
-		std::variant<T, E> _data;
+		///lvalue reference T is kept as std::reference_wrapper, so Result<T &, E> can be assigned
+		using _value_t = std::conditional_t<std::is_lvalue_reference_v<T>, std::reference_wrapper<std::remove_reference_t<T>>, T>;
+		std::variant<_value_t, E> _data;
 		T && _get_value() noexcept {
-			if (is_ok())
-				return std::move(std::get<0>(_data));
-			else
-				return std::move(*((T*)nullptr));
+			if constexpr (std::is_lvalue_reference_v<T>) {
+				if (is_ok())
+					return std::get<0>(_data).get();
+				else
+					return *((std::remove_reference_t<T>*)nullptr);
+			}
+			else {
+				if (is_ok())
+					return std::move(std::get<0>(_data));
+				else
+					return std::move(*((T*)nullptr));
+			}
 		}
 		E && _get_error() noexcept {
 			if (is_err())
@@ -77,7 +141,7 @@ namespace gc {
 				"default constructor for gc::Result<T, E> requires nothrow default constructor for E");
 		}
 		Result(detail::_Ok<T> && ok) noexcept :
-			_data(std::in_place_index<0>, std::move(ok._data))
+			_data(std::in_place_index<0>, std::forward<T>(ok._data))
 		{
 			static_assert(std::is_nothrow_move_constructible<T>::value, 
 				"gc::Result<T, E>(Ok(T)) requires nothrow move constructor for T");
@@ -100,10 +164,10 @@ namespace gc {
 			_data = std::move(r._data);
 		}
 		void operator = (detail::_Err<E> && e) {
-			_data.emplace<E>(std::move(e._data));
+			_data.template emplace<1>(std::move(e._data));
 		}
 		void operator = (detail::_Ok<T> && v) {
-			_data.emplace<T>(std::move(v._data));
+			_data.template emplace<0>(std::forward<T>(v._data));
 		}
 		bool is_ok() const noexcept {
 			return _data.index() == 0;
@@ -111,27 +175,38 @@ namespace gc {
 		bool is_err() const noexcept {
 			return !is_ok();
 		}
+		///read-only access that does not consume the Result, caller must check is_ok() first
+		const std::remove_reference_t<T> & peek_value() const noexcept {
+			if constexpr (std::is_lvalue_reference_v<T>)
+				return std::get_if<0>(&_data)->get();
+			else
+				return *std::get_if<0>(&_data);
+		}
+		///read-only access that does not consume the Result, caller must check is_err() first
+		const E & peek_error() const noexcept {
+			return *std::get_if<1>(&_data);
+		}
 		template<class Y, class F>
 		Result<Y, E> map_result_type(F && f) noexcept {
-			static_assert(gc::traits::function::is_able_to_call<F, T &&>::value,
+			static_assert(gc::traits::function::callable<F, T &&>,
 				"gc::Result<T, E>::map_result_type<Y>(f); f must be callable with T && as argument");
-			static_assert(!gc::traits::function::is_return_void_v<F, T &&>,
+			static_assert(!gc::traits::function::returns_void<F, T &&>,
 				"gc::Result<T, E>::map_result_type<Y>(f) -> gc::Result<Y, E> f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<Result<Y, E>, gc::traits::function::return_type<F, T &&>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, Result<Y, E>, T &&>,
 				"gc::Result<T, E>::map_result_type<Y>(f) -> gc::Result<Y, E> f must return value, which can be used to construct Y with no exceptions");
 
 			if (is_ok())
 				return std::move(f(_get_value()));
 			else
-				return std::move(Err(_get_error()));
+				return forward_error();
 		}
 		template<class Y, class F>
 		Result<T, Y> map_error_type(F && f) noexcept {
-			static_assert(gc::traits::function::is_able_to_call<F, E &&>::value,
+			static_assert(gc::traits::function::callable<F, E &&>,
 				"gc::Result<T, E>::map_error_type<Y>(f); f must be callable with T && as argument");
-			static_assert(!gc::traits::function::is_return_void_v<F, E&&>,
+			static_assert(!gc::traits::function::returns_void<F, E &&>,
 				"gc::Result<T, E>::map_error_type<Y>(f) -> gc::Result<T, Y> f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<Y, gc::traits::function::return_type<F, E &&>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, Y, E &&>,
 				"gc::Result<T, E>::map_error_type<Y>(f) -> gc::Result<T, Y> f must return value, which can be used to construct Y with no exceptions");
 
 			if (is_ok())
@@ -141,11 +216,11 @@ namespace gc {
 		}
 		template<class F>
 		Result & on_success(F && f) noexcept {
-			static_assert(gc::traits::function::is_able_to_call<F, T &&>::value,
+			static_assert(gc::traits::function::callable<F, T &&>,
 				"gc::Result<T, E>::on_success(f) f must be callable with T && as argument");
-			static_assert(!gc::traits::function::is_return_void_v<F, T &&>,
+			static_assert(!gc::traits::function::returns_void<F, T &&>,
 				"gc::Result<T, E>::on_success(f) f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<Result, gc::traits::function::return_type<F, T &&>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, Result, T &&>,
 				"gc::Result<T, E>::on_success(f) f must return value, which can be used to construct gc::Result<T, E> with no exceptions");
 
 			if (is_ok())
@@ -154,11 +229,11 @@ namespace gc {
 		}
 		template<class F>
 		Result & on_error(F && f) {
-			static_assert(gc::traits::function::is_able_to_call<F, E &&>::value,
+			static_assert(gc::traits::function::callable<F, E &&>,
 				"gc::Result<T, E>::on_error(f); f must be callable with E && as argument");
-			static_assert(!gc::traits::function::is_return_void_v<F, E &&>,
+			static_assert(!gc::traits::function::returns_void<F, E &&>,
 				"gc::Result<T, E>::on_success(f) f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<decltype(*this), gc::traits::function::return_type<F, E &&>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, Result, E &&>,
 				"gc::Result<T, E>::on_success(f) f must return value, which can be used to construct gc::Result<T, E> with no exceptions");
 
 			if (is_err())
@@ -166,7 +241,7 @@ namespace gc {
 			return *this;
 		}
 		T unwrap_value() {
-			return std::move(_get_value());
+			return std::forward<T>(_get_value());
 		}
 		template<class ... Args>
 		T unwrap_value_or(Args && ... args) {
@@ -176,15 +251,15 @@ namespace gc {
 			if (is_ok())
 				return _get_value();
 			else
-				return std::forward<Args>(args)...;
+				return T(std::forward<Args>(args)...);
 		}
 		template<class F>
 		T unwrap_value_or_do(F && f) {
-			static_assert(gc::traits::function::is_able_to_call_v<F>, 
+			static_assert(gc::traits::function::callable<F>, 
 				"gc::Result<T, E>::unwrap_value_or_do(f) f must be callable with no arguments (use gc::Result<T, E>::on_error to map error -> value)");
-			static_assert(!gc::traits::function::is_return_void_v<F>,
+			static_assert(!gc::traits::function::returns_void<F>,
 				"gc::Result<T, E>::unwrap_value_or_do(f) f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<T, gc::traits::function::return_type<F>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, T>,
 				"gc::Result<T, E>::unwrap_value_or_do(f) f must return value, which can be used to noexcept construct T");
 
 			if (is_ok())
@@ -192,6 +267,11 @@ namespace gc {
 			else
 				return std::move(f());
 		}
+		///error for a Result of another value type, unlike gc::Err it is not counted by telemetry,
+		///so an error passed up through several calls is recorded only where it was made
+		detail::_Err<E> forward_error() noexcept {
+			return detail::_Err<E>{ _get_error() };
+		}
 		E unwrap_error() {
 			return std::move(_get_error());
 		}
@@ -201,15 +281,15 @@ namespace gc {
 				"gc::Result<T, E>::unwrap_value_or(args ...) T{args ...} must be nothrow constructible");
 			if (is_err())
 				return _get_error();
-			return std::forward<Args>(args)...;
+			return E(std::forward<Args>(args)...);
 		}
 		template<class F>
 		E unwrap_error_or_do(F && f) {
-			static_assert(gc::traits::function::is_able_to_call_v<F>,
+			static_assert(gc::traits::function::callable<F>,
 				"gc::Result<T, E>::unwrap_error_or_do argument must be callable with no arguments (use gc::Result<T, E>::on_error to map error -> value)");
-			static_assert(!gc::traits::function::is_return_void_v<F>,
+			static_assert(!gc::traits::function::returns_void<F>,
 				"gc::Result<T, E>::unwrap_error_or_do(f) f cannot return void");
-			static_assert(std::is_nothrow_constructible_v<E, gc::traits::function::return_type<F>::type>,
+			static_assert(gc::traits::function::returns_nothrow_constructible<F, E>,
 				"gc::Result<T, E>::unwrap_error_or_do argument must return value, which can be used to noexcept construct E");
 
 			if (is_ok())
@@ -223,4 +303,14 @@ namespace gc {
 		}
 	};
 
-}
\ No newline at end of file
+#ifdef GC_ERROR_TELEMETRY
+	template<class T>
+	detail::_TracedErr::operator Result<T, Error>() && noexcept {
+		telemetry::detail::_record(_data, _location);
+		return detail::_Err<Error>{ std::move(_data) };
+	}
+#endif
+}
+#ifdef GC_ERROR_TELEMETRY
+	#include "Telemetry.hpp"
+#endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+#pragma once
+#include <new>
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+
+namespace gc {
+	namespace container {
+		///fixed-capacity FIFO, push/pop at both ends never move stored elements
+		template<class T, class Alloc = gc::memory::Allocator>
+		class RingBuffer : INonCopyable {
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"second template argument do not match gc_allocator trait");
+		public:
+			class iterator {
+				T * _data;
+				unsigned _capacity;
+				unsigned _head;
+				unsigned _index;
+			public:
+				iterator(T * data, unsigned capacity, unsigned head, unsigned index) noexcept :
+					_data(data), _capacity(capacity), _head(head), _index(index)
+				{}
+				T & operator * () const noexcept {
+					unsigned pos = _head + _index;
+					if (pos >= _capacity)
+						pos -= _capacity;
+					return _data[pos];
+				}
+				T * operator -> () const noexcept { return &**this; }
+				iterator & operator ++ () noexcept { ++_index; return *this; }
+				bool operator < (const iterator & rhs) const noexcept { return _index < rhs._index; }
+				bool operator == (const iterator & rhs) const noexcept { return _index == rhs._index; }
+				bool operator != (const iterator & rhs) const noexcept { return _index != rhs._index; }
+			};
+			//container
+			using range = Range<iterator>;
+
+			RingBuffer(RingBuffer && r) noexcept;
+			~RingBuffer() noexcept;
+
+			unsigned 	length() const noexcept;
+			unsigned 	capacity() const noexcept;
+			bool 		empty() const noexcept;
+			bool 		full() const noexcept;
+			RingBuffer & clear() noexcept;
+			template<class ... Args>
+			Result<T *, Error> push_back(Args && ... ctor_args) noexcept;
+			template<class ... Args>
+			Result<T *, Error> push_front(Args && ... ctor_args) noexcept;
+			Result<T, Error> 	pop_back() noexcept;
+			Result<T, Error> 	pop_front() noexcept;
+
+			Result<T &, Error> 			at(unsigned index) noexcept;
+			Result<const T &, Error> 	at(unsigned index) const noexcept;
+			Result<T &, Error>			front() noexcept;
+			Result<const T &, Error>	front() const noexcept;
+			Result<T &, Error>			back() noexcept;
+			Result<const T &, Error>	back() const noexcept;
+
+			RingBuffer && 	move() noexcept;
+
+			iterator 	begin() noexcept;
+			iterator 	end() noexcept;
+			range 		whole() noexcept;
+			Result<range, Error> window(unsigned from, unsigned count) noexcept;
+
+			static Result<RingBuffer<T, Alloc>, Error> make_with_capacity(unsigned capacity) noexcept;
+		private:
+			T * _slot(unsigned index) const noexcept;
+			///slice of allocated memory, size is always capacity() * sizeof(T)
+			memory::Slice _mem;
+			///physical index of the first element
+			unsigned _head;
+			unsigned _length;
+			RingBuffer(memory::Slice && sl) noexcept;
+		};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+#pragma region RingBuffer implementation
+	#pragma region constructors / destructor
+		//move constructor
+		template<class T, class Alloc>
+		RingBuffer<T, Alloc>::RingBuffer(RingBuffer && r) noexcept :
+			_mem(std::move(r._mem)), _head(r._head), _length(r._length)
+		{
+			r._mem = memory::Slice::null();
+			r._head = 0;
+			r._length = 0;
+		}
+		//constructor
+		template<class T, class Alloc>
+		RingBuffer<T, Alloc>::RingBuffer(memory::Slice && sl) noexcept :
+			_mem(std::move(sl)), _head(0), _length(0)
+		{}
+		//destructor
+		template<class T, class Alloc>
+		RingBuffer<T, Alloc>::~RingBuffer() noexcept {
+			static_assert(std::is_nothrow_destructible_v<T>,
+				"gc::container::RingBuffer<T, Alloc> T destructor must be noexcept");
+
+			if (_mem.begin_as<void>() != nullptr) {
+				clear();
+				Alloc::deallocate(std::move(_mem), alignof(T));//guaranteed to be noexcept by allocator trait
+			}
+		}
+	#pragma endregion
+	#pragma region make
+		template<class T, class Alloc>
+		Result<RingBuffer<T, Alloc>, Error> RingBuffer<T, Alloc>::make_with_capacity(unsigned count) noexcept {
+			if (count == 0)
+				return Err(Error::InvalidArgument);
+			return Alloc::allocate(sizeof(T) * count, alignof(T))
+				.template map_result_type<RingBuffer<T, Alloc>>([](memory::Slice && sl) {
+					return Ok(RingBuffer<T, Alloc>{std::move(sl)});
+				})
+			;
+		}
+	#pragma endregion
+	#pragma region container
+		template<class T, class Alloc>
+		typename RingBuffer<T, Alloc>::iterator RingBuffer<T, Alloc>::begin() noexcept {
+			return { _mem.begin_as<T>(), capacity(), _head, 0 };
+		}
+		template<class T, class Alloc>
+		typename RingBuffer<T, Alloc>::iterator RingBuffer<T, Alloc>::end() noexcept {
+			return { _mem.begin_as<T>(), capacity(), _head, _length };
+		}
+		template<class T, class Alloc>
+		typename RingBuffer<T, Alloc>::range RingBuffer<T, Alloc>::whole() noexcept {
+			return { begin(), end() };
+		}
+		template<class T, class Alloc>
+		Result<typename RingBuffer<T, Alloc>::range, Error> RingBuffer<T, Alloc>::window(unsigned from, unsigned count) noexcept {
+			if (from > _length || count > _length - from)
+				return Err(Error::OutOfRange);
+			return Ok(range{
+				iterator{ _mem.begin_as<T>(), capacity(), _head, from },
+				iterator{ _mem.begin_as<T>(), capacity(), _head, from + count }
+			});
+		}
+	#pragma endregion
+	#pragma region accessors
+		template<class T, class Alloc>
+		T * RingBuffer<T, Alloc>::_slot(unsigned index) const noexcept {
+			unsigned pos = _head + index;
+			if (pos >= capacity())
+				pos -= capacity();
+			return _mem.begin_as<T>() + pos;
+		}
+		template<class T, class Alloc>
+		Result<T &, Error> RingBuffer<T, Alloc>::at(unsigned index) noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(*_slot(index));
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> RingBuffer<T, Alloc>::at(unsigned index) const noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(static_cast<const T &>(*_slot(index)));
+		}
+		template<class T, class Alloc>
+		Result<T &, Error> RingBuffer<T, Alloc>::front() noexcept {
+			return at(0);
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> RingBuffer<T, Alloc>::front() const noexcept {
+			return at(0);
+		}
+		template<class T, class Alloc>
+		Result<T &, Error> RingBuffer<T, Alloc>::back() noexcept {
+			return at(_length - 1);//wraps to UINT_MAX when empty, so at() reports OutOfRange
+		}
+		template<class T, class Alloc>
+		Result<const T &, Error> RingBuffer<T, Alloc>::back() const noexcept {
+			return at(_length - 1);
+		}
+	#pragma endregion
+	#pragma region methods
+		template<class T, class Alloc>
+		unsigned RingBuffer<T, Alloc>::length() const noexcept {
+			return _length;
+		}
+		template<class T, class Alloc>
+		unsigned RingBuffer<T, Alloc>::capacity() const noexcept {
+			return _mem.end_as<T>() - _mem.begin_as<T>();
+		}
+		template<class T, class Alloc>
+		bool RingBuffer<T, Alloc>::empty() const noexcept {
+			return _length == 0;
+		}
+		template<class T, class Alloc>
+		bool RingBuffer<T, Alloc>::full() const noexcept {
+			return _length == capacity();
+		}
+		template<class T, class Alloc>
+		RingBuffer<T, Alloc> & RingBuffer<T, Alloc>::clear() noexcept {
+			for (unsigned i = 0; i < _length; ++i)
+				_slot(i)->~T();
+			_head = 0;
+			_length = 0;
+			return *this;
+		}
+		template<class T, class Alloc>
+		template<class ... Args>
+		Result<T *, Error> RingBuffer<T, Alloc>::push_back(Args && ... ctor_args) noexcept {
+			static_assert(std::is_nothrow_constructible<T, Args && ...>::value,
+				"gc::container::RingBuffer<T>::push_back(args...) T must be nothrow constructible with args");
+			if (full())
+				return Err(Error::OverflowError);
+			T * ptr = _slot(_length);
+			new(ptr) T(std::forward<Args>(ctor_args)...);
+			++_length;
+			return Ok(std::move(ptr));
+		}
+		template<class T, class Alloc>
+		template<class ... Args>
+		Result<T *, Error> RingBuffer<T, Alloc>::push_front(Args && ... ctor_args) noexcept {
+			static_assert(std::is_nothrow_constructible<T, Args && ...>::value,
+				"gc::container::RingBuffer<T>::push_front(args...) T must be nothrow constructible with args");
+			if (full())
+				return Err(Error::OverflowError);
+			_head = (_head == 0 ? capacity() : _head) - 1;
+			T * ptr = _mem.begin_as<T>() + _head;
+			new(ptr) T(std::forward<Args>(ctor_args)...);
+			++_length;
+			return Ok(std::move(ptr));
+		}
+		template<class T, class Alloc>
+		Result<T, Error> RingBuffer<T, Alloc>::pop_back() noexcept {
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"gc::container::RingBuffer<T>::pop_back() requires nothrow move constructible T");
+			if (empty())
+				return Err(Error::UnderflowError);
+			T * ptr = _slot(--_length);
+			Result<T, Error> res = Ok(std::move(*ptr));
+			ptr->~T();
+			return res;
+		}
+		template<class T, class Alloc>
+		Result<T, Error> RingBuffer<T, Alloc>::pop_front() noexcept {
+			static_assert(std::is_nothrow_move_constructible_v<T>,
+				"gc::container::RingBuffer<T>::pop_front() requires nothrow move constructible T");
+			if (empty())
+				return Err(Error::UnderflowError);
+			T * ptr = _mem.begin_as<T>() + _head;
+			Result<T, Error> res = Ok(std::move(*ptr));
+			ptr->~T();
+			if (++_head == capacity())
+				_head = 0;
+			--_length;
+			return res;
+		}
+		template<class T, class Alloc>
+		RingBuffer<T, Alloc> && RingBuffer<T, Alloc>::move() noexcept {
+			return std::move(*this);
+		}
+	#pragma endregion
+#pragma endregion
+	}
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+#include "Vector.hpp"
+
+namespace gc {
+	namespace serialization {
+		///binary format, version 1, integers are in host byte order:
+		///header 				: u32 magic, u16 version, u16 reserved, u32 payload size, u32 reserved
+		///Vector<T> 			: u32 length, u32 sizeof(T) if T is trivially copyable else 0, elements
+		///Result<T, Error> 	: u32 tag (0 - ok, 1 - error), T or u32 Error
+		///trivially copyable T : raw bytes aligned to alignof(T) from the buffer start,
+		///						  elements of Vector<T> are one contiguous block, so they can be viewed in place
+		constexpr std::uint32_t magic = 0x76736367;//"gcsv"
+		constexpr std::uint16_t version = 1;
+		constexpr unsigned header_size = 16;
+		///alignment of buffers made by serialize, views of T up to this alignment are always aligned
+		constexpr unsigned buffer_alignment = memory::cache_line_alignment;
+
+		namespace detail {
+			inline unsigned long long _align(unsigned long long offset, unsigned alignment) noexcept {
+				return (offset + alignment - 1) / alignment * alignment;
+			}
+			struct _Writer {
+				char * _data;
+				unsigned _offset;
+				void pad(unsigned alignment) noexcept {
+					const unsigned aligned = unsigned(_align(_offset, alignment));
+					std::memset(_data + _offset, 0, aligned - _offset);
+					_offset = aligned;
+				}
+				void write(const void * src, unsigned size) noexcept {
+					if (size != 0)
+						std::memcpy(_data + _offset, src, size);
+					_offset += size;
+				}
+				void write_u32(std::uint32_t value) noexcept {
+					pad(alignof(std::uint32_t));
+					write(&value, sizeof(value));
+				}
+			};
+			struct _Reader {
+				const char * _data;
+				unsigned _size;
+				unsigned _offset;
+				unsigned remaining() const noexcept {
+					return _size - _offset;
+				}
+				///bounds checked, RangeError if size bytes at alignment do not fit into the buffer
+				Result<const char *, Error> take(unsigned size, unsigned alignment) noexcept {
+					const unsigned long long aligned = _align(_offset, alignment);
+					if (aligned > _size || size > _size - aligned)
+						return Err(Error::RangeError);
+					_offset = unsigned(aligned) + size;
+					return Ok(_data + aligned);
+				}
+				Result<std::uint32_t, Error> read_u32() noexcept {
+					auto ptr = take(sizeof(std::uint32_t), alignof(std::uint32_t));
+					if (ptr.is_err())
+						return ptr.forward_error();
+					std::uint32_t value;
+					std::memcpy(&value, ptr.unwrap_value(), sizeof(value));
+					return Ok(std::move(value));
+				}
+			};
+
+			///measure returns offset behind t when it is written at offset
+			template<class T>
+			struct Codec {
+				static_assert(std::is_trivially_copyable_v<T>,
+					"gc::serialization T must be trivially copyable, gc::container::Vector or gc::Result<T, gc::Error>");
+				static unsigned long long measure(const T &, unsigned long long offset) noexcept {
+					return _align(offset, alignof(T)) + sizeof(T);
+				}
+				static void write(const T & t, _Writer & w) noexcept {
+					w.pad(alignof(T));
+					w.write(&t, sizeof(T));
+				}
+				static Result<T, Error> read(_Reader & r) noexcept {
+					auto ptr = r.take(sizeof(T), alignof(T));
+					if (ptr.is_err())
+						return ptr.forward_error();
+					alignas(T) unsigned char storage[sizeof(T)];
+					std::memcpy(storage, ptr.unwrap_value(), sizeof(T));
+					return Ok(std::move(*std::launder(reinterpret_cast<T *>(storage))));
+				}
+			};
+			template<class T, class Alloc>
+			struct Codec<container::Vector<T, Alloc>> {
+				using vector = container::Vector<T, Alloc>;
+				static constexpr bool raw = std::is_trivially_copyable_v<T>;
+
+				static unsigned long long measure(const vector & v, unsigned long long offset) noexcept {
+					offset = _align(offset, alignof(std::uint32_t)) + 2 * sizeof(std::uint32_t);
+					if constexpr (raw)
+						return _align(offset, alignof(T)) + (unsigned long long)sizeof(T) * v.length();
+					else {
+						for (const T & t : v)
+							offset = Codec<T>::measure(t, offset);
+						return offset;
+					}
+				}
+				static void write(const vector & v, _Writer & w) noexcept {
+					w.write_u32(v.length());
+					w.write_u32(raw ? std::uint32_t(sizeof(T)) : 0);
+					if constexpr (raw) {
+						w.pad(alignof(T));
+						w.write(v.begin(), sizeof(T) * v.length());
+					}
+					else
+						for (const T & t : v)
+							Codec<T>::write(t, w);
+				}
+				static Result<vector, Error> read(_Reader & r) noexcept {
+					auto length = r.read_u32();
+					auto element_size = r.read_u32();
+					if (length.is_err())
+						return length.forward_error();
+					if (element_size.is_err())
+						return element_size.forward_error();
+					const unsigned count = length.unwrap_value();
+					if (element_size.unwrap_value() != (raw ? sizeof(T) : 0))
+						return Err(Error::InvalidArgument);
+
+					if constexpr (raw) {
+						if ((unsigned long long)sizeof(T) * count > r.remaining())
+							return Err(Error::RangeError);
+						auto ptr = r.take(sizeof(T) * count, alignof(T));
+						if (ptr.is_err())
+							return ptr.forward_error();
+						const char * src = ptr.unwrap_value();
+						return vector::make_with_init(count, [src, count](T * dst) noexcept {
+							std::memcpy(dst, src, sizeof(T) * count);
+						});
+					}
+					else {
+						//every element takes at least one byte, do not trust length blindly
+						if (count > r.remaining())
+							return Err(Error::RangeError);
+						auto res = vector::make_with_capacity(count);
+						if (res.is_err())
+							return res.forward_error();
+						vector v = res.unwrap_value();
+						for (unsigned i = 0; i < count; ++i) {
+							auto element = Codec<T>::read(r);
+							if (element.is_err())
+								return element.forward_error();
+							v.push(element.unwrap_value());
+						}
+						return Ok(v.move());
+					}
+				}
+			};
+			template<class T>
+			struct Codec<Result<T, Error>> {
+				using result = Result<T, Error>;
+
+				static unsigned long long measure(const result & res, unsigned long long offset) noexcept {
+					offset = _align(offset, alignof(std::uint32_t)) + sizeof(std::uint32_t);
+					if (res.is_ok())
+						return Codec<T>::measure(res.peek_value(), offset);
+					return offset + sizeof(std::uint32_t);
+				}
+				static void write(const result & res, _Writer & w) noexcept {
+					w.write_u32(res.is_ok() ? 0 : 1);
+					if (res.is_ok())
+						Codec<T>::write(res.peek_value(), w);
+					else
+						w.write_u32(std::uint32_t(res.peek_error()));
+				}
+				static Result<result, Error> read(_Reader & r) noexcept {
+					auto tag = r.read_u32();
+					if (tag.is_err())
+						return tag.forward_error();
+					switch (tag.unwrap_value()) {
+					case 0: {
+						auto value = Codec<T>::read(r);
+						if (value.is_err())
+							return value.forward_error();
+						return Ok(result(Ok(value.unwrap_value())));
+					}
+					case 1: {
+						auto code = r.read_u32();
+						if (code.is_err())
+							return code.forward_error();
+						if (code.unwrap_value() > std::uint32_t(Error::UnknownError))
+							return Err(Error::InvalidArgument);
+						//stored payload, not a new error, so it is not counted by telemetry
+						return Ok(result(gc::detail::_Err<Error>{ Error(code.unwrap_value()) }));
+					}
+					default:
+						return Err(Error::InvalidArgument);
+					}
+				}
+			};
+
+			///checks header and returns reader positioned at payload
+			inline Result<_Reader, Error> _open(const memory::Slice & data) noexcept {
+				if (data.begin_as<void>() == nullptr || data.size() < header_size)
+					return Err(Error::RangeError);
+				_Reader r{ data.begin_as<const char>(), data.size(), 0 };
+				std::uint32_t head[4];
+				std::memcpy(head, r._data, header_size);
+				std::uint16_t ver;
+				std::memcpy(&ver, r._data + sizeof(std::uint32_t), sizeof(ver));
+				if (head[0] != magic || ver != version)
+					return Err(Error::InvalidArgument);
+				if (head[2] != data.size() - header_size)
+					return Err(Error::RangeError);
+				r._offset = header_size;
+				return Ok(std::move(r));
+			}
+		}
+
+		///writes v into buffer allocated by Alloc, caller releases it with Alloc::deallocate(slice, buffer_alignment)
+		template<class T, class Alloc>
+		Result<memory::Slice, Error> serialize(const container::Vector<T, Alloc> & v) noexcept {
+			using codec = detail::Codec<container::Vector<T, Alloc>>;
+			const unsigned long long size = codec::measure(v, header_size);
+			if (size > UINT_MAX)
+				return Err(Error::SizeError);
+			return Alloc::allocate(unsigned(size), buffer_alignment)
+				.on_success([&v, size](memory::Slice && sl) {
+					detail::_Writer w{ sl.begin_as<char>(), 0 };
+					w.write_u32(magic);
+					w.write(&version, sizeof(version));
+					w.write("\0", 2);
+					w.write_u32(std::uint32_t(size - header_size));
+					w.write_u32(0);
+					codec::write(v, w);
+					return Ok(sl.move());
+				})
+				.move();
+		}
+		///builds Vector from buffer made by serialize, trivially copyable elements are copied as one block
+		template<class T, class Alloc = memory::Allocator>
+		Result<container::Vector<T, Alloc>, Error> deserialize(const memory::Slice & data) noexcept {
+			auto opened = detail::_open(data);
+			if (opened.is_err())
+				return opened.forward_error();
+			detail::_Reader r = opened.unwrap_value();
+			auto res = detail::Codec<container::Vector<T, Alloc>>::read(r);
+			if (res.is_ok() && r.remaining() != 0)
+				return Err(Error::RangeError);
+			return res;
+		}
+		///zero-copy: range points into data, which must outlive it
+		///InvalidArgument if data is not aligned enough for T
+		template<class T>
+		Result<Range<const T *>, Error> view(const memory::Slice & data) noexcept {
+			static_assert(std::is_trivially_copyable_v<T>,
+				"gc::serialization::view<T>(data) T must be trivially copyable");
+			auto opened = detail::_open(data);
+			if (opened.is_err())
+				return opened.forward_error();
+			detail::_Reader r = opened.unwrap_value();
+			auto length = r.read_u32();
+			auto element_size = r.read_u32();
+			if (length.is_err())
+				return length.forward_error();
+			if (element_size.is_err())
+				return element_size.forward_error();
+			const unsigned count = length.unwrap_value();
+			if (element_size.unwrap_value() != sizeof(T))
+				return Err(Error::InvalidArgument);
+			if ((unsigned long long)sizeof(T) * count > r.remaining())
+				return Err(Error::RangeError);
+			auto ptr = r.take(sizeof(T) * count, alignof(T));
+			if (ptr.is_err())
+				return ptr.forward_error();
+			if (reinterpret_cast<std::uintptr_t>(ptr.unwrap_value()) % alignof(T) != 0)
+				return Err(Error::InvalidArgument);
+			const T * first = reinterpret_cast<const T *>(ptr.unwrap_value());
+			return Ok(Range<const T *>{ first + 0, first + count });
+		}
+	}
+}
\ No newline at end of file
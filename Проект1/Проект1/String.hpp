@@ -0,0 +1,337 @@
+#pragma once
+#include <charconv>
+#include <cstring>
+#include <functional>
+
+#include "Memory.hpp"
+#include "Allocator.hpp"
+#include "Result.hpp"
+#include "Range.hpp"
+
+namespace gc {
+	namespace container {
+		///non-owning view of characters, cheap to copy
+		class StringView {
+			const char * _data;
+			unsigned _length;
+		public:
+			constexpr StringView() noexcept :
+				_data(nullptr), _length(0)
+			{}
+			constexpr StringView(const char * data, unsigned length) noexcept :
+				_data(data), _length(length)
+			{}
+			template<unsigned N>
+			constexpr StringView(const char (&literal)[N]) noexcept :
+				_data(literal), _length(N - 1)
+			{}
+			StringView(const memory::Slice & sl) noexcept :
+				_data(sl.begin_as<const char>()), _length(sl.size())
+			{}
+
+			const char * begin() const noexcept { return _data; }
+			const char * end() const noexcept { return _data + _length; }
+			unsigned length() const noexcept { return _length; }
+			bool empty() const noexcept { return _length == 0; }
+
+			Result<char, Error> at(unsigned index) const noexcept {
+				if (index >= _length)
+					return Err(Error::OutOfRange);
+				return Ok(char(_data[index]));
+			}
+			Result<StringView, Error> sub(unsigned from, unsigned count) const noexcept {
+				if (from > _length || count > _length - from)
+					return Err(Error::OutOfRange);
+				return Ok(StringView{ _data + from, count });
+			}
+			///position of the first c at or after from, OutOfRange if there is none
+			Result<unsigned, Error> find(char c, unsigned from = 0) const noexcept {
+				if (from < _length)
+					if (auto p = static_cast<const char *>(std::memchr(_data + from, c, _length - from)))
+						return Ok(unsigned(p - _data));
+				return Err(Error::OutOfRange);
+			}
+			memory::Slice as_slice() const noexcept {
+				return memory::Slice::make(_data, _length);
+			}
+			bool operator == (const StringView & rhs) const noexcept {
+				return _length == rhs._length && (_length == 0 || std::memcmp(_data, rhs._data, _length) == 0);
+			}
+			bool operator != (const StringView & rhs) const noexcept {
+				return !(*this == rhs);
+			}
+		};
+
+		///string with small-string optimization, heap storage comes from gc allocator
+		template<class Alloc = gc::memory::Allocator>
+		class String : INonCopyable {
+			static_assert(gc::traits::gc_allocator<Alloc>,
+				"template argument do not match gc_allocator trait");
+		public:
+			//container
+			using iterator = char *;
+			using range = Range<iterator>;
+			///strings up to this length are stored inside the object
+			static constexpr unsigned sso_capacity = 15;
+			///longest string, one more byte is needed for the terminating null
+			static constexpr unsigned max_capacity = unsigned(-1) - 1;
+
+			String(String && s) noexcept;
+			~String() noexcept;
+
+			unsigned 	length() const noexcept;
+			unsigned 	capacity() const noexcept;
+			bool 		empty() const noexcept;
+			bool 		is_small() const noexcept;
+			String & 	clear() noexcept;
+			Result<String &, Error> reserve(unsigned capacity) noexcept;
+			Result<String &, Error> push(char c) noexcept;
+			Result<String &, Error> append(StringView str) noexcept;
+			bool 		operator == (const String & rhs) const noexcept;
+			bool 		operator != (const String & rhs) const noexcept;
+
+			Result<char &, Error> 		at(unsigned index) noexcept;
+			Result<const char &, Error> at(unsigned index) const noexcept;
+
+			///always null terminated
+			const char * 	c_str() const noexcept;
+			StringView 		view() const noexcept;
+
+			String && 					move() noexcept;
+			Result<String<Alloc>, Error> copy() const noexcept;
+
+			iterator 	begin() noexcept;
+			iterator 	end() noexcept;
+			range 		whole() noexcept;
+
+			static String<Alloc> make() noexcept;
+			static Result<String<Alloc>, Error> make(StringView str) noexcept;
+			static Result<String<Alloc>, Error> make_with_capacity(unsigned capacity) noexcept;
+		private:
+			///points either to _local or to memory from Alloc
+			char * _data;
+			unsigned _length;
+			unsigned _capacity;
+			char _local[sso_capacity + 1];
+			String() noexcept;
+		};
+	}
+
+	///parses whole str as T, no allocations and no exceptions
+	///InvalidArgument - str is not a number or has trailing characters
+	///OverflowError - value does not fit into T
+	template<class T>
+	Result<T, Error> parse(container::StringView str) noexcept {
+		static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+			"gc::parse<T>(str) T must be integral or floating point type");
+#ifndef __cpp_lib_to_chars
+		//floating point from_chars came later than integral one: VS 2019 16.4, libstdc++ 11
+		static_assert(std::is_integral_v<T>,
+			"gc::parse<T>(str) floating point T requires std::from_chars for floating point types");
+#endif
+		T value{};
+		auto [ptr, ec] = std::from_chars(str.begin(), str.end(), value);
+		if (ec == std::errc::result_out_of_range)
+			return Err(Error::OverflowError);
+		if (ec != std::errc() || ptr != str.end())
+			return Err(Error::InvalidArgument);
+		return Ok(std::move(value));
+	}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+	namespace container {
+#pragma region String implementation
+	#pragma region constructors / destructor
+		//constructor
+		template<class Alloc>
+		String<Alloc>::String() noexcept :
+			_data(_local), _length(0), _capacity(sso_capacity)
+		{
+			_local[0] = '\0';
+		}
+		//move constructor
+		template<class Alloc>
+		String<Alloc>::String(String && s) noexcept :
+			String()
+		{
+			if (s.is_small()) {
+				std::memcpy(_local, s._local, s._length + 1);
+			}
+			else {
+				_data = s._data;
+				_capacity = s._capacity;
+			}
+			_length = s._length;
+			s._data = s._local;
+			s._capacity = sso_capacity;
+			s._length = 0;
+			s._local[0] = '\0';
+		}
+		//destructor
+		template<class Alloc>
+		String<Alloc>::~String() noexcept {
+			if (!is_small())
+				Alloc::deallocate(memory::Slice::make(_data, _capacity + 1), alignof(char));//guaranteed to be noexcept by allocator trait
+		}
+	#pragma endregion
+	#pragma region make
+		template<class Alloc>
+		String<Alloc> String<Alloc>::make() noexcept {
+			return {};
+		}
+		template<class Alloc>
+		Result<String<Alloc>, Error> String<Alloc>::make(StringView str) noexcept {
+			String<Alloc> s;
+			auto res = s.append(str);
+			if (res.is_err())
+				return res.forward_error();
+			return Ok(s.move());
+		}
+		template<class Alloc>
+		Result<String<Alloc>, Error> String<Alloc>::make_with_capacity(unsigned capacity) noexcept {
+			String<Alloc> s;
+			auto res = s.reserve(capacity);
+			if (res.is_err())
+				return res.forward_error();
+			return Ok(s.move());
+		}
+	#pragma endregion
+	#pragma region container
+		template<class Alloc>
+		typename String<Alloc>::iterator String<Alloc>::begin() noexcept {
+			return _data;
+		}
+		template<class Alloc>
+		typename String<Alloc>::iterator String<Alloc>::end() noexcept {
+			return _data + _length;
+		}
+		template<class Alloc>
+		typename String<Alloc>::range String<Alloc>::whole() noexcept {
+			return { begin(), end() };
+		}
+	#pragma endregion
+	#pragma region methods
+		template<class Alloc>
+		unsigned String<Alloc>::length() const noexcept {
+			return _length;
+		}
+		template<class Alloc>
+		unsigned String<Alloc>::capacity() const noexcept {
+			return _capacity;
+		}
+		template<class Alloc>
+		bool String<Alloc>::empty() const noexcept {
+			return _length == 0;
+		}
+		template<class Alloc>
+		bool String<Alloc>::is_small() const noexcept {
+			return _data == _local;
+		}
+		template<class Alloc>
+		String<Alloc> & String<Alloc>::clear() noexcept {
+			_length = 0;
+			_data[0] = '\0';
+			return *this;
+		}
+		template<class Alloc>
+		Result<String<Alloc> &, Error> String<Alloc>::reserve(unsigned capacity) noexcept {
+			if (capacity <= _capacity)
+				return Ok(*this);
+			if (capacity > max_capacity)
+				return Err(Error::OverflowError);
+			return Alloc::allocate(capacity + 1, alignof(char))
+				.template map_result_type<String<Alloc> &>([this, capacity](memory::Slice && sl) {
+					std::memcpy(sl.begin_as<char>(), _data, _length + 1);
+					if (!is_small())
+						Alloc::deallocate(memory::Slice::make(_data, _capacity + 1), alignof(char));
+					_data = sl.begin_as<char>();
+					_capacity = capacity;
+					return Ok(*this);
+				});
+		}
+		template<class Alloc>
+		Result<String<Alloc> &, Error> String<Alloc>::push(char c) noexcept {
+			return append(StringView{ &c, 1 });
+		}
+		template<class Alloc>
+		Result<String<Alloc> &, Error> String<Alloc>::append(StringView str) noexcept {
+			const unsigned length = _length + str.length();
+			if (length < _length)
+				return Err(Error::OverflowError);
+			if (length > _capacity) {
+				//str may view this string, its characters are freed by reserve(), so remember where they were
+				const std::less<const char *> less;
+				const bool own = !less(str.begin(), _data) && less(str.begin(), _data + _length);
+				const unsigned offset = own ? unsigned(str.begin() - _data) : 0;
+				//grow geometrically, so repeated push is amortized O(1)
+				const unsigned doubled = _capacity > max_capacity / 2 ? max_capacity : _capacity * 2;
+				const unsigned grown = doubled > length ? doubled : length;
+				auto res = reserve(grown);
+				if (res.is_err())
+					return res.forward_error();
+				if (own)
+					str = StringView{ _data + offset, str.length() };
+			}
+			if (!str.empty())
+				std::memcpy(_data + _length, str.begin(), str.length());
+			_length = length;
+			_data[_length] = '\0';
+			return Ok(*this);
+		}
+		template<class Alloc>
+		bool String<Alloc>::operator == (const String<Alloc> & s) const noexcept {
+			return view() == s.view();
+		}
+		template<class Alloc>
+		bool String<Alloc>::operator != (const String<Alloc> & s) const noexcept {
+			return !(*this == s);
+		}
+		template<class Alloc>
+		Result<char &, Error> String<Alloc>::at(unsigned index) noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(_data[index]);
+		}
+		template<class Alloc>
+		Result<const char &, Error> String<Alloc>::at(unsigned index) const noexcept {
+			if (index >= _length)
+				return Err(Error::OutOfRange);
+			return Ok(static_cast<const char &>(_data[index]));
+		}
+		template<class Alloc>
+		const char * String<Alloc>::c_str() const noexcept {
+			return _data;
+		}
+		template<class Alloc>
+		StringView String<Alloc>::view() const noexcept {
+			return { _data, _length };
+		}
+		template<class Alloc>
+		String<Alloc> && String<Alloc>::move() noexcept {
+			return std::move(*this);
+		}
+		template<class Alloc>
+		Result<String<Alloc>, Error> String<Alloc>::copy() const noexcept {
+			return make(view());
+		}
+	#pragma endregion
+#pragma endregion
+	}
+}
\ No newline at end of file
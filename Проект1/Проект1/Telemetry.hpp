@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <source_location>
+
+#include "Result.hpp"
+
+#ifndef GC_ERROR_TELEMETRY
+	#error "Telemetry.hpp requires GC_ERROR_TELEMETRY to be defined for the whole program"
+#endif
+
+namespace gc {
+	namespace telemetry {
+		constexpr unsigned error_count = unsigned(Error::UnknownError) + 1;
+		///distinct call sites tracked per thread, errors from further sites are only counted per kind
+		constexpr unsigned site_capacity = 256;
+
+		struct SiteCount {
+			const char * file;
+			const char * function;
+			std::uint32_t line;
+			Error error;
+			std::uint64_t count;
+		};
+		///errors produced by all threads, alive and finished, since program start
+		struct Snapshot {
+			std::uint64_t by_error[error_count];
+			SiteCount sites[site_capacity];
+			unsigned site_count;
+			///errors whose call site did not fit into site_capacity
+			std::uint64_t dropped;
+
+			std::uint64_t count(Error error) const noexcept {
+				return by_error[unsigned(error)];
+			}
+		};
+
+		namespace detail {
+			struct _Site {
+				///published last with release, so readers see other fields once file is not null
+				std::atomic<const char *> file;
+				const char * function;
+				std::uint32_t line;
+				Error error;
+				std::atomic<std::uint64_t> count;
+			};
+			///written only by its own thread, read by snapshot() under _mutex()
+			struct _Table {
+				std::atomic<std::uint64_t> by_error[error_count];
+				_Site sites[site_capacity];
+				std::atomic<std::uint64_t> dropped;
+				_Table * next;
+
+				_Table() noexcept :
+					by_error{}, sites{}, dropped(0), next(nullptr)
+				{}
+			};
+			inline void _increment(std::atomic<std::uint64_t> & counter, std::uint64_t n = 1) noexcept {
+				//single writer, so no read-modify-write is needed
+				counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			}
+			inline std::mutex & _mutex() noexcept {
+				static std::mutex m;
+				return m;
+			}
+			///list of tables of alive threads
+			inline _Table *& _head() noexcept {
+				static _Table * head = nullptr;
+				return head;
+			}
+			///counts of finished threads, guarded by _mutex()
+			inline Snapshot & _retired() noexcept {
+				static Snapshot retired{};
+				return retired;
+			}
+			inline void _add(Snapshot & s, const char * file, const char * function, std::uint32_t line, Error error, std::uint64_t count) noexcept {
+				for (unsigned i = 0; i < s.site_count; ++i)
+					//same file may have different name pointers in different translation units
+					if (s.sites[i].line == line && s.sites[i].error == error && std::strcmp(s.sites[i].file, file) == 0) {
+						s.sites[i].count += count;
+						return;
+					}
+				if (s.site_count == site_capacity)
+					s.dropped += count;
+				else
+					s.sites[s.site_count++] = { file, function, line, error, count };
+			}
+			inline void _merge(Snapshot & s, const _Table & t) noexcept {
+				for (unsigned i = 0; i < error_count; ++i)
+					s.by_error[i] += t.by_error[i].load(std::memory_order_relaxed);
+				s.dropped += t.dropped.load(std::memory_order_relaxed);
+				for (const _Site & site : t.sites)
+					if (const char * file = site.file.load(std::memory_order_acquire))
+						_add(s, file, site.function, site.line, site.error, site.count.load(std::memory_order_relaxed));
+			}
+			///registers thread table on first error in the thread, folds it into _retired() on thread exit
+			struct _ThreadTable {
+				_Table table;
+				_ThreadTable() noexcept {
+					std::lock_guard<std::mutex> lock(_mutex());
+					table.next = _head();
+					_head() = &table;
+				}
+				~_ThreadTable() noexcept {
+					std::lock_guard<std::mutex> lock(_mutex());
+					_merge(_retired(), table);
+					for (_Table ** i = &_head(); *i; i = &(*i)->next)
+						if (*i == &table) {
+							*i = table.next;
+							break;
+						}
+				}
+			};
+
+			template<class>
+			GC_COLD void _record(Error error, std::source_location location) noexcept {
+				static thread_local _ThreadTable thread_table;
+				_Table & t = thread_table.table;
+				_increment(t.by_error[unsigned(error)]);
+
+				const char * file = location.file_name();
+				const std::uint32_t line = location.line();
+				unsigned slot = unsigned((reinterpret_cast<std::uintptr_t>(file) >> 3) ^ (line * 0x9E3779B1u) ^ unsigned(error)) % site_capacity;
+				for (unsigned probe = 0; probe < site_capacity; ++probe, slot = (slot + 1) % site_capacity) {
+					_Site & site = t.sites[slot];
+					const char * used = site.file.load(std::memory_order_relaxed);
+					if (used == nullptr) {
+						site.function = location.function_name();
+						site.line = line;
+						site.error = error;
+						site.count.store(1, std::memory_order_relaxed);
+						site.file.store(file, std::memory_order_release);
+						return;
+					}
+					if (used == file && site.line == line && site.error == error) {
+						_increment(site.count);
+						return;
+					}
+				}
+				_increment(t.dropped);
+			}
+		}
+
+		///aggregates counters of all threads, takes a lock, so do not call it on hot paths
+		inline Snapshot snapshot() noexcept {
+			Snapshot s{};
+			std::lock_guard<std::mutex> lock(detail::_mutex());
+			const Snapshot & retired = detail::_retired();
+			for (unsigned i = 0; i < error_count; ++i)
+				s.by_error[i] = retired.by_error[i];
+			s.dropped = retired.dropped;
+			for (unsigned i = 0; i < retired.site_count; ++i)
+				detail::_add(s, retired.sites[i].file, retired.sites[i].function, retired.sites[i].line, retired.sites[i].error, retired.sites[i].count);
+			for (const detail::_Table * t = detail::_head(); t; t = t->next)
+				detail::_merge(s, *t);
+			return s;
+		}
+	}
+}
\ No newline at end of file
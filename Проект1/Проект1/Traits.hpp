@@ -1,40 +1,57 @@
 #pragma once
+#include <concepts>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 namespace gc {
 	namespace traits {
 		namespace function {
-			template<class T, class ... Args>
+		//callable
+			///F has round brackets which take passed arguments
+			template<class F, class ... Args>
+			concept callable = requires(F && f, Args && ... args) {
+				std::forward<F>(f)(std::forward<Args>(args)...);
+			};
+		//return_type_t
+			///type of return value of functor, F must be callable with Args
+			template<class F, class ... Args>
+			using return_type_t = decltype(std::declval<F>()(std::declval<Args>()...));
+		//returns_void
+			template<class F, class ... Args>
+			concept returns_void = callable<F, Args ...> && std::is_void_v<return_type_t<F, Args ...>>;
+		//returns_nothrow_constructible
+			///F is callable with Args and its return value can construct Target with no exceptions
+			template<class F, class Target, class ... Args>
+			concept returns_nothrow_constructible = callable<F, Args ...> && std::is_nothrow_constructible_v<Target, return_type_t<F, Args ...>>;
+
+			//class templates below are kept for existing users, they are thin wrappers over concepts
 		//is_able_to_call
+			template<class T, class ... Args>
 			class is_able_to_call {
-				struct detection {};
-				template<class Y>
-				static decltype(std::declval<Y>()(std::forward<Args>(std::declval<Args>())...))
-					detect(const Y &) {}
-				static detection
-					detect(...) {}
 			public:
 				///if type T has round brackets which takes passed arguments, then value == true
-				static constexpr bool value = !std::is_same<detection, decltype(detect(std::declval<T>()))>::value;
+				static constexpr bool value = callable<T, Args ...>;
 			};
 			template<class T, class ... Args>
-			constexpr bool is_able_to_call_v = is_able_to_call<T, Args ... >::value;
+			constexpr bool is_able_to_call_v = callable<T, Args ... >;
 		//return_type
 			template<class T, class ... Args>
 			class return_type {
-				static_assert(is_able_to_call<T, Args...>::value, "passing noncallable object to 'return_type' metafunction");
+				static_assert(callable<T, Args...>, "passing noncallable object to 'return_type' metafunction");
 			public:
 				///type contain type of return value of functor
-				using type = decltype(std::declval<T>()(std::forward<Args>(std::declval<Args>())...));
+				using type = return_type_t<T, Args ...>;
 			};
 		//is_return_void
 			template<class F, class ... Args>
 			class is_return_void {
-				static_assert(is_able_to_call<F, Args ...>::value, "passing noncallable object to 'is_return_void' metafunction");
+				static_assert(callable<F, Args ...>, "passing noncallable object to 'is_return_void' metafunction");
 			public:
-				static constexpr bool value = std::is_same<void, return_type<F, Args ...>::type>::value;
+				static constexpr bool value = returns_void<F, Args ...>;
 			};
 			template<class T, class ... Args>
-			constexpr bool is_return_void_v = is_return_void<T, Args ... >::value;
+			constexpr bool is_return_void_v = returns_void<T, Args ... >;
 		}
 		namespace type {
 		//lvalue_reference
@@ -74,22 +91,19 @@ namespace gc {
 				static constexpr bool value = true;
 			};
 		}
+		///has move() returning T && and copy() returning T
+		template<class T>
+		concept gc_class = requires(T && t) {
+			{ std::move(t).move() } -> std::same_as<T &&>;
+			{ std::move(t).copy() } -> std::same_as<T>;
+		};
 		template<class T>
 		class is_gc_class {
-			struct detecter {};
-			static constexpr detecter detection(...) {}
-			template<class Y>
-			static constexpr 
-			typename std::enable_if<
-				   std::is_same_v<decltype(std::declval<Y>().move()), Y &&>		//if has "move()"
-				&& std::is_same_v<decltype(std::declval<Y>().copy()), Y>		//if has "copy()"
-				, void>::type
-			detection(Y &&) {}
 		public:
-			static constexpr bool value = !std::is_same_v<decltype(detection(std::declval<T>())), detecter>;
+			static constexpr bool value = gc_class<T>;
 		};
 		template<class T>
-		constexpr bool is_gc_class_v = is_gc_class<T>::value;
+		constexpr bool is_gc_class_v = gc_class<T>;
 	}
 	class INonCopyable {
 		INonCopyable(const INonCopyable &) = delete;
@@ -10,11 +10,12 @@ namespace gc {
 	namespace container {
 		template<class T, class Alloc = gc::memory::Allocator>
 		class Vector : INonCopyable {
-			static_assert(gc::traits::is_gc_allocator_v<Alloc>,
+			static_assert(gc::traits::gc_allocator<Alloc>,
 				"second template argument do not match gc_allocator trait");
 		public:
 			//container
 			using iterator = T *;
+			using const_iterator = const T *;
 			using range = Range<iterator>;
 			
 			Vector(Vector && v) noexcept;
@@ -48,6 +49,8 @@ namespace gc {
 
 			iterator 	begin() noexcept;
 			iterator 	end() noexcept;
+			const_iterator 	begin() const noexcept;
+			const_iterator 	end() const noexcept;
 			range 		whole() noexcept;
 
 
@@ -57,9 +60,10 @@ namespace gc {
 			template<class ... Args>
 			static Result<Vector<T, Alloc>, Error> make_with_elements(Args && ... elements) noexcept;
 			static Result<Vector<T, Alloc>, Error> make_with_capacity(unsigned capacity) noexcept;
-			static Result<Vector<T, Alloc>, Error> make_from_raw(T * ptr, unsigned size, T * last = ptr) noexcept;
+			template<class F>
+			static Result<Vector<T, Alloc>, Error> make_with_init(unsigned count, F && init) noexcept;
+			static Result<Vector<T, Alloc>, Error> make_from_raw(T * ptr, unsigned size, T * last = nullptr) noexcept;
 		private:
-			void _reallocate(unsigned new_size) noexcept;
 			///slice of allocated memory
 			memory::Slice _mem;
 			///ptr to memory behind last element
@@ -111,7 +115,7 @@ namespace gc {
 				for (T * i = _mem.begin_as<T>(); i < _last; ++i)
 					i->~T();//call destructor for everyone, asserted to be noexcept
 				
-				Alloc::deallocate(std::move(_mem));//guaranteed to be noexcept by allocator trait
+				Alloc::deallocate(std::move(_mem), alignof(T));//guaranteed to be noexcept by allocator trait
 			}
 		}
 	#pragma endregion
@@ -127,14 +131,14 @@ namespace gc {
 				"gc::container::Vector<T>::make(size, args...) T must be nothrow constructible with args");
 			if (count == 0)
 				return Ok(make());
-			return Alloc::allocate(sizeof(T) * count)
+			return Alloc::allocate(sizeof(T) * count, alignof(T))
 				.on_success([&args..., &count](memory::Slice && sl) {
 					T * ptr = sl.begin_as<T>();
 					for (unsigned i = 0; i < count; ++i)
 						new(ptr + i) T(std::forward<Args>(args)...);//asserted to be noexcept
 					return Ok(std::move(sl));
 				})
-				.map_result_type<Vector<T, Alloc>>([&count](memory::Slice && sl) {
+				.template map_result_type<Vector<T, Alloc>>([&count](memory::Slice && sl) {
 					T * ptr = sl.begin_as<T>() + count;
 					return Ok(Vector<T, Alloc>{std::move(sl), ptr});
 				})
@@ -142,16 +146,36 @@ namespace gc {
 		}
 		template<class T, class Alloc>
 		Result<Vector<T, Alloc>, Error> Vector<T, Alloc>::make_with_capacity(unsigned count) noexcept {
-			return Alloc::allocate(sizeof(T) * count)
-				.map_result_type<Vector<T, Alloc>>([](memory::Slice && sl) {
+			return Alloc::allocate(sizeof(T) * count, alignof(T))
+				.template map_result_type<Vector<T, Alloc>>([](memory::Slice && sl) {
 					T * ptr = sl.begin_as<T>();
 					return Ok(Vector<T, Alloc>{std::move(sl), ptr});
 				})
 			;
 		}
+		///init(T * first) must construct all count elements in place with no exceptions
 		template<class T, class Alloc>
-		Result<Vector<T, Alloc>, Error> Vector<T, Alloc>::make_from_raw(T * ptr, unsigned count, T * last = ptr) noexcept {
-			if (ptr == nullptr || count == 0u || last == nullptr || (last < ptr))
+		template<class F>
+		Result<Vector<T, Alloc>, Error> Vector<T, Alloc>::make_with_init(unsigned count, F && init) noexcept {
+			static_assert(gc::traits::function::callable<F, T *>,
+				"gc::container::Vector<T>::make_with_init(count, f) f must be callable with T * as argument");
+			static_assert(std::is_nothrow_invocable_v<F, T *>,
+				"gc::container::Vector<T>::make_with_init(count, f) f must be noexcept");
+			if (count == 0)
+				return Ok(make());
+			return Alloc::allocate(sizeof(T) * count, alignof(T))
+				.template map_result_type<Vector<T, Alloc>>([&init, &count](memory::Slice && sl) {
+					T * ptr = sl.begin_as<T>();
+					init(ptr);
+					return Ok(Vector<T, Alloc>{std::move(sl), ptr + count});
+				})
+			;
+		}
+		template<class T, class Alloc>
+		Result<Vector<T, Alloc>, Error> Vector<T, Alloc>::make_from_raw(T * ptr, unsigned count, T * last) noexcept {
+			if (last == nullptr)
+				last = ptr;
+			if (ptr == nullptr || count == 0u || (last < ptr))
 				return Err(Error::InvalidArgument);
 			return Ok(Vector<T, Alloc> {memory::Slice{ ptr, count }.move(), last});
 		}
@@ -166,6 +190,14 @@ namespace gc {
 			return _last;
 		}
 		template<class T, class Alloc>
+		typename Vector<T, Alloc>::const_iterator Vector<T, Alloc>::begin() const noexcept{
+			return _mem.begin_as<T>();
+		}
+		template<class T, class Alloc>
+		typename Vector<T, Alloc>::const_iterator Vector<T, Alloc>::end() const noexcept{
+			return _last;
+		}
+		template<class T, class Alloc>
 		typename Vector<T, Alloc>::range Vector<T, Alloc>::whole() noexcept{
 			return {begin(), end()};
 		}
@@ -195,7 +227,6 @@ namespace gc {
 		typename Vector<T, Alloc>::iterator Vector<T, Alloc>::push(Args && ... ctor_args) noexcept{
 			auto ptr = _last++;
 			new(ptr) T(std::forward<Args>(ctor_args)...);
-			_mem.inc_size(sizeof(T));
 			return ptr;
 		}
 
@@ -214,18 +245,6 @@ namespace gc {
 		}
 
 
-		template<class T, class Alloc>
-		Result<memory::Slice, Error> Vector<T, Alloc>::_reallocate(unsigned new_size) {
-			static_assert(std::nothrow_move_constructible_v<T>, "Vector<T>::realloc requires nothrow move constructible T");
-			return Alloc::allocate(new_size * sizeof(T))
-				.on_success([this](memory::Slice && m) {				
-					for (unsigned i = 0; i < length(); ++i)
-						new(_m.begin_as<T>() + i) T(std::move(_mem.begin_as<T>()[i]));
-					for (T * i = _mem.begin_as<T>(); i < _last; ++i)
-						i->~T();
-					return gc::Ok(m.move());
-				});
-		}
 		template<class T, class Alloc>
 		Vector<T, Alloc> && Vector<T, Alloc>::move() noexcept {
 			return std::move(*this);
@@ -234,14 +253,14 @@ namespace gc {
 		inline Result<Vector<T, Alloc>, Error> Vector<T, Alloc>::copy() const noexcept {
 			if (length() == 0)
 				return Ok(make());
-			return Alloc::allocate(sizeof(T) * count)
+			return Alloc::allocate(sizeof(T) * length(), alignof(T))
 				.on_success([this](memory::Slice && sl) {
 					T * ptr = sl.begin_as<T>();
-					for (unsigned i = 0; i < count; ++i)
+					for (unsigned i = 0; i < length(); ++i)
 						new(ptr + i) T(_mem.begin_as<T>()[i].copy());//asserted to be noexcept
 					return Ok(sl.move());
 				})
-				.map_result_type<Vector<T, Alloc>>([this](memory::Slice && sl) {
+				.template map_result_type<Vector<T, Alloc>>([this](memory::Slice && sl) {
 					T * ptr = sl.begin_as<T>() + length();
 					return Ok(Vector<T, Alloc>{sl.move(), ptr});
 				})
@@ -6,6 +6,18 @@
 #include "Allocator.hpp"
 #include "Memory.hpp"
 #include "Vector.hpp"
+#include "RingBuffer.hpp"
+#include "Deque.hpp"
+#include "String.hpp"
+#include "Serialization.hpp"
+#include "HugePageAllocator.hpp"
+#include "BitVector.hpp"
+#include "ObjectPool.hpp"
+#ifdef GC_ERROR_TELEMETRY
+	#include <cstring>
+	#include <thread>
+	#include "Telemetry.hpp"
+#endif
 
 void assert(bool cond) {
 	static uint32_t count = 1;
@@ -46,7 +58,371 @@ void debug(T && t) {
 	std::cout << gc::TypeName<T>::get() << ':' << ' ' << t << std::endl;
 }
 
+void test_result_reference() {
+	int value = 5;
+	gc::Result<int &, gc::Error> r = gc::Ok(value);
+	assert(r.is_ok() && &r.unwrap_value() == &value);
+	r.unwrap_value() = 7;
+	assert(value == 7);
+	int other = 1;
+	r = gc::Ok(other);
+	assert(&r.unwrap_value() == &other && value == 7);
+	r = gc::Err(gc::Error::OutOfRange);
+	assert(r.is_err() && r.unwrap_error() == gc::Error::OutOfRange);
+}
+
+void test_ring_buffer() {
+	using namespace gc::container;
+	assert(RingBuffer<int>::make_with_capacity(0).unwrap_error() == gc::Error::InvalidArgument);
+	auto r = RingBuffer<int>::make_with_capacity(4).unwrap_value();
+	r.push_back(1);
+	r.push_back(2);
+	r.push_back(3);
+	r.push_front(0);
+	assert(r.full() && r.length() == 4);
+	assert(r.push_back(4).unwrap_error() == gc::Error::OverflowError);
+	assert(r.at(0).unwrap_value() == 0 && r.at(3).unwrap_value() == 3);
+	assert(r.at(4).unwrap_error() == gc::Error::OutOfRange);
+	//head moves, so the next push_back wraps around the end of the buffer
+	assert(r.pop_front().unwrap_value() == 0);
+	r.push_back(4);
+	assert(r.front().unwrap_value() == 1 && r.back().unwrap_value() == 4);
+	int sum = 0;
+	r.whole().foreach([&](int i) { sum += i; });
+	assert(sum == 1 + 2 + 3 + 4);
+	sum = 0;
+	r.window(1, 2).unwrap_value().foreach([&](int i) { sum = sum * 10 + i; });
+	assert(sum == 23);
+	assert(r.window(3, 2).unwrap_error() == gc::Error::OutOfRange);
+	r.at(1).unwrap_value() = 20;
+	assert(r.at(1).unwrap_value() == 20);
+	assert(r.pop_back().unwrap_value() == 4 && r.pop_back().unwrap_value() == 3);
+	r.clear();
+	assert(r.empty() && r.back().unwrap_error() == gc::Error::OutOfRange);
+	assert(r.pop_front().unwrap_error() == gc::Error::UnderflowError);
+}
+
+void test_deque() {
+	using namespace gc::container;
+	constexpr unsigned block = Deque<int>::block_length;
+	auto d = Deque<int>::make();
+	assert(d.pop_back().unwrap_error() == gc::Error::UnderflowError);
+	//several blocks at both ends, d holds -front_count .. back_count - 1
+	const int back_count = int(block * 2 + 5);
+	const int front_count = int(block + 3);
+	int * first = d.push_back(0).unwrap_value();
+	for (int i = 1; i < back_count; ++i)
+		d.push_back(i);
+	for (int i = 1; i <= front_count; ++i)
+		d.push_front(-i);
+	assert(d.length() == unsigned(back_count + front_count));
+	assert(&d.at(front_count).unwrap_value() == first);//never relocated
+	bool ordered = true;
+	for (unsigned i = 0; i < d.length(); ++i)
+		ordered = ordered && d.at(i).unwrap_value() == int(i) - front_count;
+	assert(ordered);
+	assert(d.front().unwrap_value() == -front_count && d.back().unwrap_value() == back_count - 1);
+	assert(d.at(d.length()).unwrap_error() == gc::Error::OutOfRange);
+	//window crossing a block boundary
+	long long sum = 0;
+	unsigned count = 0;
+	d.window(block - 2, 4).unwrap_value().foreach([&](int i) { sum += i; ++count; });
+	const int w = int(block) - 2 - front_count;
+	assert(count == 4 && sum == w + (w + 1) + (w + 2) + (w + 3));
+	assert(d.window(1, d.length()).unwrap_error() == gc::Error::OutOfRange);
+	//pops cross block boundaries and release emptied blocks
+	for (int i = back_count - 1; i >= 0; --i)
+		ordered = ordered && d.pop_back().unwrap_value() == i;
+	for (int i = front_count; i >= 1; --i)
+		ordered = ordered && d.pop_front().unwrap_value() == -i;
+	assert(ordered && d.empty());
+	assert(d.pop_front().unwrap_error() == gc::Error::UnderflowError);
+	d.push_front(1);
+	assert(d.back().unwrap_value() == 1);
+}
+
+///allocator which always fails, used to check that containers pass the allocator error through
+struct FailingAllocator {
+	static gc::Result<gc::memory::Slice, gc::Error> allocate(unsigned, unsigned) noexcept {
+		return gc::Err(gc::Error::InsufficientRights);
+	}
+	static void deallocate(gc::memory::Slice &&, unsigned) noexcept {}
+};
+
+void test_string() {
+	using namespace gc::container;
+	auto s = String<>::make("hello").unwrap_value();
+	assert(s.is_small() && s.length() == 5 && s.view() == StringView("hello"));
+	s.append(", small string").unwrap_value().push('!');
+	assert(!s.is_small() && s.view() == StringView("hello, small string!") && s.c_str()[s.length()] == '\0');
+	//source inside own heap buffer, which is reallocated by the append
+	while (s.capacity() > s.length())
+		s.push('.');
+	const auto before = s.copy().unwrap_value();
+	s.append(s.view().sub(0, 5).unwrap_value());
+	assert(s.length() == before.length() + 5 && s.view().sub(before.length(), 5).unwrap_value() == StringView("hello"));
+	s.append(s.view());
+	assert(s.view().sub(0, s.length() / 2).unwrap_value() == s.view().sub(s.length() / 2, s.length() / 2).unwrap_value());
+	//length overflow is detected before any character is read
+	assert(s.append(StringView{ s.c_str(), unsigned(-1) }).unwrap_error() == gc::Error::OverflowError);
+	//no room for the terminating null, rejected before allocate(capacity + 1) wraps to 0
+	assert(String<>::make_with_capacity(0xFFFFFFFF).unwrap_error() == gc::Error::OverflowError);
+	assert(s.reserve(String<>::max_capacity + 1).unwrap_error() == gc::Error::OverflowError);
+	assert(String<FailingAllocator>::make_with_capacity(100).unwrap_error() == gc::Error::InsufficientRights);
+	assert(String<FailingAllocator>::make("a string longer than sso").unwrap_error() == gc::Error::InsufficientRights);
+
+	StringView v("a,bc,d");
+	assert(v.find(',').unwrap_value() == 1 && v.find(',', 2).unwrap_value() == 4);
+	assert(v.find(';').unwrap_error() == gc::Error::OutOfRange);
+	assert(v.sub(2, 2).unwrap_value() == StringView("bc") && v.sub(5, 2).is_err());
+	assert(v.at(5).unwrap_value() == 'd' && v.at(6).unwrap_error() == gc::Error::OutOfRange);
+
+	assert(gc::parse<int>("-123").unwrap_value() == -123);
+	assert(gc::parse<int>("12a").unwrap_error() == gc::Error::InvalidArgument);
+	assert(gc::parse<int>("").unwrap_error() == gc::Error::InvalidArgument);
+	assert(gc::parse<int>("99999999999").unwrap_error() == gc::Error::OverflowError);
+	assert(gc::parse<unsigned char>("255").unwrap_value() == 255 && gc::parse<unsigned char>("256").is_err());
+	assert(gc::parse<double>("2.5").unwrap_value() == 2.5);
+	assert(gc::parse<double>("1e999").unwrap_error() == gc::Error::OverflowError);
+}
+
+void test_serialization() {
+	using namespace gc::container;
+	namespace ser = gc::serialization;
+	using Alloc = gc::memory::Allocator;
+	auto v = Vector<int>::make_with_init(1000, [](int * p) noexcept {
+		for (int i = 0; i < 1000; ++i)
+			new(p + i) int(i);
+	}).unwrap_value();
+	auto buffer = ser::serialize(v).unwrap_value();
+	assert(buffer.begin_as<char>() != nullptr && reinterpret_cast<std::uintptr_t>(buffer.begin_as<void>()) % ser::buffer_alignment == 0);
+	assert(ser::deserialize<int>(buffer).unwrap_value() == v);
+	//zero-copy view points into the buffer itself
+	long long sum = 0;
+	auto view = ser::view<int>(buffer).unwrap_value();
+	view.foreach([&](const int & i) { sum += i; });
+	assert(sum == 999 * 1000 / 2);
+	assert(ser::deserialize<short>(buffer).unwrap_error() == gc::Error::InvalidArgument);
+	assert(ser::view<short>(buffer).unwrap_error() == gc::Error::InvalidArgument);
+	//truncated buffer and corrupted length
+	assert(ser::deserialize<int>(gc::memory::Slice::make(buffer.begin_as<char>(), buffer.size() - 4)).unwrap_error() == gc::Error::RangeError);
+	assert(ser::deserialize<int>(gc::memory::Slice::make(buffer.begin_as<char>(), 8)).unwrap_error() == gc::Error::RangeError);
+	buffer.begin_as<std::uint32_t>()[4] = 1001;
+	assert(ser::deserialize<int>(buffer).unwrap_error() == gc::Error::RangeError);
+	assert(ser::view<int>(buffer).unwrap_error() == gc::Error::RangeError);
+	buffer.begin_as<std::uint32_t>()[0] = 0;
+	assert(ser::deserialize<int>(buffer).unwrap_error() == gc::Error::InvalidArgument);
+	Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+
+	//nested vectors and Result payloads
+	auto nested = Vector<Vector<int>>::make_with_capacity(3).unwrap_value();
+	for (int n = 0; n < 3; ++n)
+		nested.push(Vector<int>::make(unsigned(n), n).unwrap_value());
+	buffer = ser::serialize(nested).unwrap_value();
+	auto nested_copy = ser::deserialize<Vector<int>>(buffer).unwrap_value();
+	bool same = nested_copy.length() == 3;
+	for (unsigned n = 0; same && n < 3; ++n)
+		same = nested_copy.begin()[n] == nested.begin()[n];
+	assert(same);
+	Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+
+	auto results = Vector<gc::Result<double, gc::Error>>::make_with_capacity(2).unwrap_value();
+	results.push(gc::Ok(1.5));
+	results.push(gc::Err(gc::Error::DomainError));
+	buffer = ser::serialize(results).unwrap_value();
+	auto results_copy = ser::deserialize<gc::Result<double, gc::Error>>(buffer).unwrap_value();
+	assert(results_copy.length() == 2 && results_copy.begin()[0].peek_value() == 1.5);
+	assert(results_copy.begin()[1].peek_error() == gc::Error::DomainError);
+	Alloc::deallocate(buffer.move(), ser::buffer_alignment);
+}
+
+struct alignas(64) CacheLine {
+	char bytes[64];
+};
+
+void test_allocators() {
+	using namespace gc::memory;
+	static_assert(gc::traits::gc_allocator<Allocator> && gc::traits::gc_allocator<HugePageAllocator>
+		&& gc::traits::gc_allocator<AlignedAllocator<simd_alignment>>, "allocators must match gc_allocator trait");
+	bool aligned = true;
+	for (unsigned alignment : { 1u, 16u, 64u, 4096u }) {
+		auto sl = Allocator::allocate(100, alignment).unwrap_value();
+		aligned = aligned && reinterpret_cast<std::uintptr_t>(sl.begin_as<void>()) % alignment == 0;
+		Allocator::deallocate(sl.move(), alignment);
+	}
+	assert(aligned);
+	assert(Allocator::allocate(100, 3).unwrap_error() == gc::Error::InvalidArgument);
+	assert(Allocator::allocate(100, 0).unwrap_error() == gc::Error::InvalidArgument);
+	auto line = AlignedAllocator<cache_line_alignment>::allocate(10, 1).unwrap_value();
+	assert(reinterpret_cast<std::uintptr_t>(line.begin_as<void>()) % cache_line_alignment == 0);
+	AlignedAllocator<cache_line_alignment>::deallocate(line.move(), 1);
+	//overaligned T in Vector
+	auto lines = gc::container::Vector<CacheLine>::make(4).unwrap_value();
+	assert(reinterpret_cast<std::uintptr_t>(lines.begin()) % alignof(CacheLine) == 0);
+
+	auto huge = HugePageAllocator::allocate(3u << 20, 64).unwrap_value();
+	huge.begin_as<char>()[0] = 1;
+	huge.begin_as<char>()[huge.size() - 1] = 2;
+	assert(huge.size() == 3u << 20 && reinterpret_cast<std::uintptr_t>(huge.begin_as<void>()) % HugePageAllocator::max_alignment == 0);
+	HugePageAllocator::deallocate(huge.move(), 64);
+	assert(HugePageAllocator::allocate(0, 1).unwrap_value().begin_as<void>() == nullptr);
+	assert(HugePageAllocator::allocate(10, 8192).unwrap_error() == gc::Error::InvalidArgument);
+}
+
+void test_bit_vector() {
+	using namespace gc::container;
+	auto a = BitVector<>::make(300).unwrap_value();
+	assert(a.length() == 300 && a.count() == 0 && a.find_first().unwrap_error() == gc::Error::OutOfRange);
+	a.set(0).unwrap_value().set(63).unwrap_value().set(64).unwrap_value().set(299);
+	assert(a.at(63).unwrap_value() && !a.at(62).unwrap_value() && a.at(300).unwrap_error() == gc::Error::OutOfRange);
+	assert(a.set(300).unwrap_error() == gc::Error::OutOfRange);
+	assert(a.count() == 4 && a.find_first().unwrap_value() == 0);
+	assert(a.find_next(0).unwrap_value() == 63 && a.find_next(64).unwrap_value() == 299);
+	assert(a.find_next(299).unwrap_error() == gc::Error::OutOfRange);
+	unsigned sum = 0;
+	a.ones().foreach([&](unsigned i) { sum += i; });
+	assert(sum == 0 + 63 + 64 + 299);
+	//bulk operations work on whole words, tail bits behind length must stay clear
+	auto b = BitVector<>::make(300, true).unwrap_value();
+	assert(b.count() == 300);
+	b.set(63, false);
+	auto c = a.copy().unwrap_value();
+	c.and_with(b);
+	assert(c.count() == 3 && !c.at(63).unwrap_value());
+	c.xor_with(b);
+	assert(c.count() == 296);
+	c.or_with(a);
+	assert(c.count() == 300 && c == BitVector<>::make(300, true).unwrap_value());
+	c.and_not_with(a);
+	assert(c.count() == 296 && !c.at(299).unwrap_value());
+	assert(c.and_with(BitVector<>::make(299).unwrap_value()).unwrap_error() == gc::Error::SizeError);
+	c.fill(false);
+	assert(c.count() == 0 && c != a);
+	//word count of such length does not fit into unsigned
+	assert(BitVector<>::make(0xFFFFFFFF).unwrap_error() == gc::Error::SizeError);
+	assert(BitVector<>::make(0).unwrap_value().empty());
+}
+
+struct Movable {
+	Movable && move() { return std::move(*this); }
+	Movable copy() { return {}; }
+};
+
+void test_traits() {
+	using namespace gc::traits;
+	auto add = [](int a, int b) noexcept { return a + b; };
+	auto log = [](const char *) {};
+	auto name = [](int) { return "x"; };
+	assert(function::callable<decltype(add), int, int> && !function::callable<decltype(add), int>);
+	assert(!function::callable<int> && function::callable<decltype(log), const char *>);
+	assert(function::returns_void<decltype(log), const char *> && !function::returns_void<decltype(add), int, int>);
+	assert(function::returns_nothrow_constructible<decltype(add), long, int, int>);
+	//std::string(const char *) may throw
+	assert(!function::returns_nothrow_constructible<decltype(name), std::string, int>);
+	assert(!function::returns_nothrow_constructible<decltype(add), long, int>);
+	//old class templates agree with the concepts
+	assert(function::is_able_to_call<decltype(add), int, int>::value && !function::is_able_to_call_v<decltype(add)>);
+	assert(function::is_return_void<decltype(log), const char *>::value && !function::is_return_void_v<decltype(add), int, int>);
+	assert(std::is_same_v<function::return_type<decltype(name), int>::type, const char *>);
+	assert(gc_class<Movable> && is_gc_class_v<Movable> && !gc_class<int>);
+	assert(gc_allocator<gc::memory::Allocator> && gc_allocator<FailingAllocator> && !is_gc_allocator_v<Movable>);
+}
+
+///counts live instances, to check that the pool destroys exactly the objects it holds
+struct Counted {
+	static int alive;
+	int value;
+	Counted(int v) noexcept : value(v) { ++alive; }
+	~Counted() noexcept { --alive; }
+};
+int Counted::alive = 0;
+
+void test_object_pool() {
+	using namespace gc::container;
+	using Pool = ObjectPool<Counted>;
+	{
+		auto p = Pool::make();
+		assert(p.empty() && p.capacity() == 0 && Pool::Handle().get().unwrap_error() == gc::Error::OutOfRange);
+		auto a = p.acquire(1).unwrap_value();
+		auto b = p.acquire(2).unwrap_value();
+		Counted * first = &a.get().unwrap_value();
+		//more than one chunk, objects never move
+		for (int i = 0; i < int(Pool::chunk_length) * 2; ++i)
+			p.acquire(i);
+		assert(p.length() == Pool::chunk_length * 2 + 2 && Counted::alive == int(p.length()));
+		assert(&a.get().unwrap_value() == first && first->value == 1 && b.get().unwrap_value().value == 2);
+		//stale handle, also after its slot is reused
+		p.release(a).unwrap_value();
+		assert(!a.alive() && a.get().unwrap_error() == gc::Error::OutOfRange);
+		assert(p.release(a).unwrap_error() == gc::Error::OutOfRange);
+		auto c = p.acquire(3).unwrap_value();
+		assert(&c.get().unwrap_value() == first && !a.alive() && a != c);
+		assert(Counted::alive == int(p.length()));
+		//live handle of another pool
+		auto other = Pool::make();
+		auto foreign = other.acquire(4).unwrap_value();
+		assert(p.release(foreign).unwrap_error() == gc::Error::OutOfRange && foreign.alive());
+		//iteration sees every live object once, iterator gives its handle back
+		long long sum = 0;
+		unsigned count = 0;
+		p.whole().foreach([&](Counted & x) { sum += x.value; ++count; });
+		const long long n = Pool::chunk_length * 2;
+		assert(count == p.length() && sum == 2 + 3 + n * (n - 1) / 2);
+		bool handles = true;
+		for (auto i = p.begin(); i != p.end(); ++i)
+			handles = handles && &i.handle().get().unwrap_value() == &*i;
+		assert(handles);
+		p.clear();
+		assert(p.empty() && !b.alive() && !c.alive() && Counted::alive == 1);
+	}
+	assert(Counted::alive == 0);
+	auto reserved = Pool::make_with_capacity(Pool::chunk_length + 1).unwrap_value();
+	assert(reserved.capacity() == Pool::chunk_length * 2 && reserved.empty());
+	assert(ObjectPool<int, FailingAllocator>::make_with_capacity(1).unwrap_error() == gc::Error::InsufficientRights);
+	assert(ObjectPool<int, FailingAllocator>::make().acquire(1).unwrap_error() == gc::Error::InsufficientRights);
+}
+
+#ifdef GC_ERROR_TELEMETRY
+void test_telemetry() {
+	using namespace gc::telemetry;
+	const Snapshot before = snapshot();
+	//errors are counted where they are made, passing them up does not count them again
+	auto chained = get(1)
+		.map_result_type<long>([](int && i) { return gc::Ok(long(i)); })
+		.map_result_type<double>([](long && l) { return gc::Ok(double(l)); });
+	assert(chained.peek_error() == gc::Error::DomainError);
+	std::thread([] {
+		get(2);
+		get(3);
+	}).join();
+	assert(gc::container::String<FailingAllocator>::make_with_capacity(100).is_err());
+	const Snapshot after = snapshot();
+	assert(after.count(gc::Error::DomainError) - before.count(gc::Error::DomainError) == 3);
+	assert(after.count(gc::Error::InsufficientRights) - before.count(gc::Error::InsufficientRights) == 1);
+	bool at_origin = true;
+	for (unsigned i = 0; i < after.site_count; ++i) {
+		const SiteCount & site = after.sites[i];
+		if (site.error == gc::Error::DomainError || site.error == gc::Error::InsufficientRights)
+			at_origin = at_origin && std::strstr(site.file, "main.cpp") != nullptr;
+		at_origin = at_origin && std::strstr(site.file, "Result.hpp") == nullptr;
+	}
+	assert(at_origin);
+}
+#endif
+
 int main() {
+#ifdef GC_ERROR_TELEMETRY
+	test_telemetry();
+#endif
+	test_traits();
+	test_result_reference();
+	test_ring_buffer();
+	test_deque();
+	test_string();
+	test_serialization();
+	test_allocators();
+	test_bit_vector();
+	test_object_pool();
 	using namespace gc::container;
 	/*
 	Vector<int>::make(5, 45)